@@ -35,28 +35,11 @@
  *    - No explicit "deleted" flag needed
  */
 
+#include "mutable_chain.h"
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <stdbool.h>
-
-/* Forward declarations */
-typedef struct NodeWrapper NodeWrapper;
-typedef struct Node Node;
-
-/* Wrapper structure - the indirection layer */
-struct NodeWrapper {
-    Node *node;
-};
-
-/* Node structure - represents data in the chain */
-struct Node {
-    NodeWrapper *to;       /* Forward reference wrapper */
-    NodeWrapper *from;     /* Backward reference wrapper */
-    char *data;            /* Node data (NULL for terminal/initial) */
-    bool is_initial;       /* Flag for initial node */
-    bool is_terminal;      /* Flag for terminal node */
-};
 
 /*
  * Create a new wrapper pointing to a node
@@ -102,7 +85,7 @@ Node* create_node(const char *data) {
 /*
  * Create initial node
  */
-Node* create_initial_node() {
+Node* create_initial_node(void) {
     Node *node = create_node(NULL);
     node->is_initial = true;
     return node;
@@ -111,7 +94,7 @@ Node* create_initial_node() {
 /*
  * Create terminal node
  */
-Node* create_terminal_node() {
+Node* create_terminal_node(void) {
     Node *node = create_node(NULL);
     node->is_terminal = true;
     return node;
@@ -190,26 +173,19 @@ void link_data_remove(Node *a_link) {
  *         }
  *     }
  *     link_iterator(start, false, process_node, NULL);
+ *
+ * When the per-node work is small, CHAIN_FOREACH or a ChainCursor (see
+ * mutable_chain.h) avoids the indirect call per node.
  */
 void link_iterator(Node *a_link, bool reverse, void (*callback)(Node*, void*), void *user_data) {
-    Node *current = a_link;
+    ChainCursor cursor = chain_cursor_begin(a_link, reverse);
+    Node *next_node;
     
-    while (true) {
-        /* Get the next node from the current wrapper reference */
-        Node *next_node = reverse ? current->from->node : current->to->node;
-        
-        /* Check for termination */
-        if ((reverse && next_node->is_initial) || (!reverse && next_node->is_terminal)) {
-            break;
-        }
-        
-        /* Call the callback with the next node */
+    /* chain_cursor_next reads the current node's wrapper and stops at the
+     * terminal (initial) node. If the node just visited was deleted, it's
+     * orphaned, but its wrapper still leads to the successor/predecessor. */
+    while ((next_node = chain_cursor_next(&cursor)) != NULL) {
         callback(next_node, user_data);
-        
-        /* Move to the next node */
-        /* If next_node was just deleted, it's orphaned, but the wrapper */
-        /* has been updated to point to the successor/predecessor */
-        current = next_node;
     }
 }
 
@@ -231,10 +207,165 @@ void free_node(Node *node) {
     }
 }
 
+/* ============================================================================
+ * ARENA-BACKED CHAINS
+ * ============================================================================
+ *
+ * create_node costs two mallocs (three with data) and link_to_and_from two
+ * more, all freed one by one. An arena node is a single carve instead:
+ *
+ *     [ Node | to wrapper | from wrapper | data bytes ]
+ *
+ * so a node, both of its wrappers and its payload share a cache line or
+ * two. The wrappers belong to the node for life, just like the inline Ref
+ * slots of the C++ version; linking and link_data_remove only ever change
+ * their contents.
+ */
+
+#define CHAIN_ARENA_DEFAULT_BLOCK 16384
+#define CHAIN_ARENA_ALIGN sizeof(void*)
+
+typedef struct ArenaBlock ArenaBlock;
+
+struct ArenaBlock {
+    ArenaBlock *next;      /* Next block, in allocation order */
+    size_t size;           /* Usable bytes in data */
+    size_t used;           /* Bytes handed out since the last reset */
+    char data[];           /* Carved storage */
+};
+
+struct ChainArena {
+    ArenaBlock *first;     /* Oldest block (where a reset restarts) */
+    ArenaBlock *current;   /* Block being carved */
+    size_t block_size;     /* Size of regular blocks */
+};
+
+static size_t arena_round_up(size_t bytes) {
+    return (bytes + CHAIN_ARENA_ALIGN - 1) & ~(CHAIN_ARENA_ALIGN - 1);
+}
+
+static ArenaBlock* arena_new_block(size_t size) {
+    ArenaBlock *block = (ArenaBlock*)malloc(sizeof(ArenaBlock) + size);
+    if (!block) {
+        fprintf(stderr, "Memory allocation failed for arena block\n");
+        exit(1);
+    }
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+/*
+ * Carve bytes from the arena.
+ *
+ * Blocks kept from before a reset are reused in order; a request larger
+ * than a regular block gets a block of its own.
+ */
+static void* arena_carve(ChainArena *arena, size_t bytes) {
+    ArenaBlock *block = arena->current;
+    bytes = arena_round_up(bytes);
+    
+    while (block->size - block->used < bytes) {
+        if (!block->next) {
+            size_t size = bytes > arena->block_size ? bytes : arena->block_size;
+            block->next = arena_new_block(size);
+        }
+        block = block->next;
+        block->used = 0;
+    }
+    arena->current = block;
+    
+    void *p = block->data + block->used;
+    block->used += bytes;
+    return p;
+}
+
+ChainArena* chain_arena_create(size_t block_size) {
+    ChainArena *arena = (ChainArena*)malloc(sizeof(ChainArena));
+    if (!arena) {
+        fprintf(stderr, "Memory allocation failed for arena\n");
+        exit(1);
+    }
+    arena->block_size = arena_round_up(block_size ? block_size : CHAIN_ARENA_DEFAULT_BLOCK);
+    arena->first = arena_new_block(arena->block_size);
+    arena->current = arena->first;
+    return arena;
+}
+
+Node* chain_arena_node(ChainArena *arena, const char *data) {
+    size_t node_size = arena_round_up(sizeof(Node));
+    size_t wrapper_size = arena_round_up(sizeof(NodeWrapper));
+    size_t header = node_size + 2 * wrapper_size;
+    size_t length = data ? strlen(data) + 1 : 0;
+    char *p = (char*)arena_carve(arena, header + length);
+    
+    Node *node = (Node*)p;
+    node->to = (NodeWrapper*)(p + node_size);
+    node->from = (NodeWrapper*)(p + node_size + wrapper_size);
+    node->to->node = NULL;
+    node->from->node = NULL;
+    node->is_initial = false;
+    node->is_terminal = false;
+    
+    if (data) {
+        node->data = p + header;
+        memcpy(node->data, data, length);
+    } else {
+        node->data = NULL;
+    }
+    
+    return node;
+}
+
+Node* chain_arena_initial_node(ChainArena *arena) {
+    Node *node = chain_arena_node(arena, NULL);
+    node->is_initial = true;
+    return node;
+}
+
+Node* chain_arena_terminal_node(ChainArena *arena) {
+    Node *node = chain_arena_node(arena, NULL);
+    node->is_terminal = true;
+    return node;
+}
+
+/*
+ * Link two arena nodes.
+ *
+ * Same result as link_to_and_from, but the wrappers already exist: only
+ * their contents are written.
+ */
+void chain_arena_link(Node *a_link, Node *a_data) {
+    a_link->to->node = a_data;
+    a_data->from->node = a_link;
+}
+
+void chain_arena_reset(ChainArena *arena) {
+    arena->current = arena->first;
+    arena->first->used = 0;
+}
+
+void chain_arena_destroy(ChainArena *arena) {
+    if (arena) {
+        ArenaBlock *block = arena->first;
+        while (block) {
+            ArenaBlock *next = block->next;
+            free(block);
+            block = next;
+        }
+        free(arena);
+    }
+}
+
 /* ============================================================================
  * EXAMPLE USAGE
  * ============================================================================ */
 
+/* Build with MUTABLE_CHAIN_NO_MAIN to use this file as a library
+ * (the benchmark suite links it that way). */
+#ifndef MUTABLE_CHAIN_NO_MAIN
+
 /* Callback for forward iteration that removes data1 */
 void forward_callback(Node *node, void *user_data) {
     if (node->data && strcmp(node->data, "data1!") == 0) {
@@ -279,5 +410,30 @@ int main() {
     free_node(data3);
     free_node(terminal);
     
+    /* Same chain carved from an arena: one carve per node, one call to free */
+    ChainArena *arena = chain_arena_create(0);
+    Node *head = chain_arena_initial_node(arena);
+    Node *tail = chain_arena_terminal_node(arena);
+    Node *last = head;
+    const char *values[] = {"data1!", "data2!", "data3!"};
+    for (int i = 0; i < 3; i++) {
+        Node *node = chain_arena_node(arena, values[i]);
+        chain_arena_link(last, node);
+        last = node;
+    }
+    chain_arena_link(last, tail);
+    
+    printf("\nArena chain (delete data1):\n");
+    link_iterator(head, false, forward_callback, NULL);
+    
+    /* Same walk without a callback: the loop body is inlined */
+    printf("\nCHAIN_FOREACH_REVERSE (tail -> head):\n");
+    CHAIN_FOREACH_REVERSE(node, tail) {
+        printf("  -  %s\n", node->data);
+    }
+    chain_arena_destroy(arena);
+    
     return 0;
 }
+
+#endif /* MUTABLE_CHAIN_NO_MAIN */
@@ -1,512 +1,42 @@
 /**
  * @file mutable_chain.cpp
- * @brief List-Wrapper Based Reference Management Pattern - Modern C++ Implementation
+ * @brief Example driver for MutableList<T> (see mutable_chain.hpp)
  *
- * This module demonstrates a reference addressing mechanism using shared_ptr
- * wrappers (Ref<T>) to enable safe mutation of chain structures during iteration.
- *
- * @section pattern PATTERN EXPLANATION
- *
- * Instead of storing direct pointers between nodes:
- * @code
- *     node->next = other_node;              // Direct pointer
- * @endcode
- *
- * We use shared_ptr wrappers as an indirection layer:
- * @code
- *     node->next = make_shared<Ref<Node>>(other_node);  // Wrapped reference
- * @endcode
- *
- * @section benefits BENEFITS OF REF<T> WRAPPERS
- *
- * 1. **SHARED REFERENCE INDIRECTION**:
- *    - Multiple nodes can hold a shared_ptr to the same Ref wrapper
- *    - Updating the wrapper's ptr member affects all referencing nodes
- *    - When we change what's inside the wrapper, all holders see the update
- *
- * 2. **MUTABLE IDENTITY**:
- *    - The Ref wrapper's identity (address) stays the same
- *    - Only its contents (ptr member) change during mutations
- *    - All shared_ptrs to the wrapper remain valid after restructuring
- *
- * 3. **SAFE DELETION DURING ITERATION**:
- *    - When deleting a node, we update wrapper contents, not reassign pointers
- *    - The iterator's reference to predecessor->next still points to same Ref
- *    - That Ref now contains the successor, so iteration continues seamlessly
- *    - No explicit "deleted" flag or iterator invalidation handling needed
- *
- * 4. **AUTOMATIC MEMORY MANAGEMENT**:
- *    - shared_ptr provides automatic reference counting
- *    - Nodes are freed when no longer referenced
- *    - No manual memory management required
- *
- * @section deletion DELETION MECHANISM
- *
- * When we delete node B from chain A -> B -> C:
- *
- * Before deletion:
- * @code
- *     A.next = Ref{B}     B.prev = Ref{A}
- *     B.next = Ref{C}     C.prev = Ref{B}
- * @endcode
- *
- * Deletion updates Ref contents (not the Ref objects themselves):
- * @code
- *     A.next->ptr = C     // Same Ref object, now points to C
- *     C.prev->ptr = A     // Same Ref object, now points to A
- * @endcode
- *
- * After deletion (Ref objects unchanged, contents updated):
- * @code
- *     A.next = Ref{C}     // Same Ref object identity
- *     C.prev = Ref{A}     // Same Ref object identity
- * @endcode
- *
- * @section iteration ITERATION WITH DELETION
- *
- * The iterator holds a pointer to the current node.
- * When that node is deleted:
- * - The node's next Ref still exists and now points to successor
- * - operator++ follows next->ptr which leads to the correct successor
- * - Iteration continues seamlessly without special handling
- *
- * @section usecases USE CASES
- *
- * - Doubly-linked lists with concurrent deletion
- * - Graph structures with mutable node connections
- * - Priority queues with dynamic reordering
- * - Undo/redo systems where connections are restructured
- * - Scene graphs in graphics engines where nodes are reparented
- * - Any structure requiring safe modification during traversal
- *
- * @section stl STL COMPLIANCE
- *
- * MutableList<T> models the following STL concepts:
- * - Container (begin, end, size, empty, clear)
- * - ReversibleContainer (rbegin, rend)
- * - SequenceContainer (front, back, push_back, push_front, pop_back, pop_front)
- * - AllocatorAwareContainer (allocator_type template parameter)
- *
- * @author Based on Python reference implementation
- * @version 2.0 (Modern C++ rewrite with templates and STL compliance)
+ * Walks through the same scenario as the Python reference implementation:
+ * erase an element mid-iteration, then traverse the survivors forward,
+ * in reverse, and with a range-based for loop. Ends with the chunked and
+ * concurrent variants: ChunkedMutableList, and a producer thread feeding a
+ * ConcurrentMutableList while the main thread erases from it, an
+ * MpscMutableQueue fed by two producers, a parallel_for_each pass on a
+ * WorkStealingPool, and a VersionedMutableList snapshot that ignores later
+ * writes. A MultiMutableList shows one element sitting in two chains, and
+ * an LruCache relinks entries on every hit, and compact() restores node
+ * locality after a sort.
  */
 
+#include "mutable_chain.hpp"
+#include "mutable_chain_chunked.hpp"
+#include "mutable_chain_concurrent.hpp"
+#include "mutable_chain_handles.hpp"
+#include "mutable_chain_indexed.hpp"
+#include "mutable_chain_io.hpp"
+#include "mutable_chain_lru.hpp"
+#include "mutable_chain_multi.hpp"
+#include "mutable_chain_parallel.hpp"
+#include "mutable_chain_queue.hpp"
+#include "mutable_chain_versioned.hpp"
+#include "mutable_chain_views.hpp"
+
+#ifdef MUTABLE_CHAIN_COROUTINES
+#include "mutable_chain_coro.hpp"
+#endif
+
+#include <atomic>
+#include <cstdio>
 #include <iostream>
 #include <iterator>
-#include <memory>
-#include <utility>
-
-// ============================================================================
-// GENERIC COMPONENTS
-// ============================================================================
-
-/**
- * @brief Templatized wrapper providing indirection layer - the core pattern.
- *
- * Ref<T> wraps a shared_ptr<T> to enable updating what a reference points to
- * without changing the Ref object itself. Multiple shared_ptr<Ref<T>> can
- * point to the same Ref, and updating Ref::ptr affects all of them.
- *
- * @tparam T The type being referenced (typically a node type)
- *
- * @code
- *     auto ref = make_shared<Ref<Node>>(nodeA);
- *     auto ref_alias = ref;  // Both point to same Ref
- *     ref->ptr = nodeB;      // Both ref and ref_alias now see nodeB
- * @endcode
- */
-template <typename T>
-struct Ref
-{
-    std::shared_ptr<T> ptr; ///< The actual pointer, mutable for indirection
-    explicit Ref(std::shared_ptr<T> p) : ptr(std::move(p)) {}
-};
-
-/**
- * @brief Generic doubly-linked node holding a value of type T.
- *
- * Uses Ref<ListNode<T>> for next/prev links to enable safe mutation.
- * The value is stored directly in the node (not wrapped).
- *
- * @tparam T The value type stored in this node
- */
-template <typename T>
-struct ListNode
-{
-    using RefType = Ref<ListNode<T>>;        ///< The Ref type for this node
-    using RefPtr = std::shared_ptr<RefType>; ///< Shared pointer to Ref
-
-    RefPtr next; ///< Forward link (wrapped for safe mutation)
-    RefPtr prev; ///< Backward link (wrapped for safe mutation)
-    T value;     ///< The stored value
-
-    /// Default constructor for sentinel nodes (no value initialization)
-    ListNode() = default;
-
-    /// Value constructor with perfect forwarding
-    template <typename... Args>
-    explicit ListNode(Args &&...args) : value(std::forward<Args>(args)...) {}
-};
-
-/**
- * @brief STL-compliant doubly-linked list with safe deletion during iteration.
- *
- * MutableList<T> is a container that allows elements to be erased while
- * iterating without invalidating the iterator. This is achieved through
- * the Ref<T> indirection pattern.
- *
- * Models: Container, ReversibleContainer, SequenceContainer (partial)
- *
- * @tparam T The element type
- * @tparam Allocator The allocator type (default: std::allocator<T>)
- *
- * @code
- *     MutableList<std::string> list{"a", "b", "c"};
- *
- *     // Safe deletion during iteration - just like Python!
- *     for (auto it = list.begin(); it != list.end(); ++it) {
- *         if (*it == "b") {
- *             list.erase(it);  // No special handling needed!
- *         }
- *     }
- * @endcode
- */
-template <typename T, typename Allocator = std::allocator<T>>
-class MutableList
-{
-public:
-    // ========================================================================
-    // STL TYPE ALIASES
-    // ========================================================================
-    using value_type = T;                       ///< Element type
-    using allocator_type = Allocator;           ///< Allocator type
-    using size_type = std::size_t;              ///< Unsigned integer type for sizes
-    using difference_type = std::ptrdiff_t;     ///< Signed integer type for differences
-    using reference = value_type &;             ///< Reference to element
-    using const_reference = const value_type &; ///< Const reference to element
-    using pointer = typename std::allocator_traits<Allocator>::pointer;
-    using const_pointer = typename std::allocator_traits<Allocator>::const_pointer;
-
-private:
-    using Node = ListNode<T>;
-    using NodePtr = std::shared_ptr<Node>;
-    using RefType = typename Node::RefType;
-    using RefPtr = typename Node::RefPtr;
-
-    NodePtr head_;       ///< Sentinel node before first element
-    NodePtr tail_;       ///< Sentinel node after last element
-    size_type size_ = 0; ///< Number of elements
-
-    /**
-     * @brief Create bidirectional link between two nodes using Ref wrappers.
-     *
-     * This is the key linking operation. It creates NEW Ref objects for
-     * each direction. The Ref wrappers enable later mutation.
-     */
-    static void link(const NodePtr &a, const NodePtr &b)
-    {
-        a->next = std::make_shared<RefType>(b);
-        b->prev = std::make_shared<RefType>(a);
-    }
-
-    /// Create an empty sentinel node
-    static NodePtr makeSentinel()
-    {
-        return std::make_shared<Node>();
-    }
-
-public:
-    // ========================================================================
-    // ITERATOR
-    // ========================================================================
-
-    /**
-     * @brief Bidirectional iterator with const/non-const support.
-     *
-     * The iterator stores a shared_ptr to the current node. When dereferenced,
-     * it returns a reference to the node's value. Incrementing follows
-     * current_->next->ptr, which works correctly even if the current node
-     * was just erased (because next->ptr has been updated to skip it).
-     *
-     * @tparam IsConst If true, produces const references
-     */
-    template <bool IsConst>
-    class IteratorImpl
-    {
-        friend class MutableList;
-        NodePtr current_;
-
-    public:
-        // STL iterator traits
-        using iterator_category = std::bidirectional_iterator_tag;
-        using value_type = std::conditional_t<IsConst, const T, T>;
-        using difference_type = std::ptrdiff_t;
-        using pointer = value_type *;
-        using reference = value_type &;
-
-        IteratorImpl() = default;
-        explicit IteratorImpl(NodePtr node) : current_(std::move(node)) {}
-
-        /// Allow conversion from non-const to const iterator
-        template <bool WasConst, typename = std::enable_if_t<IsConst && !WasConst>>
-        IteratorImpl(const IteratorImpl<WasConst> &other) : current_(other.current_) {}
-
-        reference operator*() const { return current_->value; }
-        pointer operator->() const { return &current_->value; }
-
-        /// Pre-increment: advance to next node via Ref indirection
-        IteratorImpl &operator++()
-        {
-            current_ = current_->next->ptr;
-            return *this;
-        }
-
-        IteratorImpl operator++(int)
-        {
-            IteratorImpl tmp = *this;
-            ++(*this);
-            return tmp;
-        }
-
-        /// Pre-decrement: move to previous node via Ref indirection
-        IteratorImpl &operator--()
-        {
-            current_ = current_->prev->ptr;
-            return *this;
-        }
-
-        IteratorImpl operator--(int)
-        {
-            IteratorImpl tmp = *this;
-            --(*this);
-            return tmp;
-        }
-
-        bool operator==(const IteratorImpl &o) const { return current_ == o.current_; }
-        bool operator!=(const IteratorImpl &o) const { return current_ != o.current_; }
-
-        /// Get underlying node pointer (for erase operations)
-        NodePtr node() const { return current_; }
-    };
-
-    using iterator = IteratorImpl<false>;
-    using const_iterator = IteratorImpl<true>;
-    using reverse_iterator = std::reverse_iterator<iterator>;
-    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
-
-    // ========================================================================
-    // CONSTRUCTION / DESTRUCTION
-    // ========================================================================
-
-    /// Default constructor: creates empty list with sentinel nodes
-    MutableList() : head_(makeSentinel()), tail_(makeSentinel())
-    {
-        link(head_, tail_);
-    }
-
-    /// Initializer list constructor
-    MutableList(std::initializer_list<T> init) : MutableList()
-    {
-        for (const auto &v : init)
-            push_back(v);
-    }
-
-    /// Copy constructor
-    MutableList(const MutableList &other) : MutableList()
-    {
-        for (const auto &v : other)
-            push_back(v);
-    }
-
-    /// Move constructor
-    MutableList(MutableList &&other) noexcept
-        : head_(std::move(other.head_)),
-          tail_(std::move(other.tail_)),
-          size_(other.size_)
-    {
-        other.head_ = makeSentinel();
-        other.tail_ = makeSentinel();
-        link(other.head_, other.tail_);
-        other.size_ = 0;
-    }
-
-    /// Copy/move assignment (copy-and-swap idiom)
-    MutableList &operator=(MutableList other)
-    {
-        swap(other);
-        return *this;
-    }
-
-    /// Swap contents with another list
-    void swap(MutableList &other) noexcept
-    {
-        std::swap(head_, other.head_);
-        std::swap(tail_, other.tail_);
-        std::swap(size_, other.size_);
-    }
-
-    // ========================================================================
-    // ITERATORS
-    // ========================================================================
-
-    iterator begin() { return iterator(head_->next->ptr); }
-    iterator end() { return iterator(tail_); }
-    const_iterator begin() const { return const_iterator(head_->next->ptr); }
-    const_iterator end() const { return const_iterator(tail_); }
-    const_iterator cbegin() const { return begin(); }
-    const_iterator cend() const { return end(); }
-
-    reverse_iterator rbegin() { return reverse_iterator(end()); }
-    reverse_iterator rend() { return reverse_iterator(begin()); }
-    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
-    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
-    const_reverse_iterator crbegin() const { return rbegin(); }
-    const_reverse_iterator crend() const { return rend(); }
-
-    // ========================================================================
-    // CAPACITY
-    // ========================================================================
-
-    /// Check if the list is empty
-    [[nodiscard]] bool empty() const { return size_ == 0; }
-
-    /// Get the number of elements
-    [[nodiscard]] size_type size() const { return size_; }
-
-    // ========================================================================
-    // ELEMENT ACCESS
-    // ========================================================================
-
-    /// Access the first element
-    reference front() { return head_->next->ptr->value; }
-    const_reference front() const { return head_->next->ptr->value; }
-
-    /// Access the last element
-    reference back() { return tail_->prev->ptr->value; }
-    const_reference back() const { return tail_->prev->ptr->value; }
-
-    // ========================================================================
-    // MODIFIERS
-    // ========================================================================
-
-    /// Remove all elements
-    void clear()
-    {
-        link(head_, tail_);
-        size_ = 0;
-    }
-
-    /**
-     * @brief Construct element in-place at the end.
-     * @param args Arguments forwarded to T's constructor
-     * @return Reference to the inserted element
-     */
-    template <typename... Args>
-    reference emplace_back(Args &&...args)
-    {
-        auto node = std::make_shared<Node>(std::forward<Args>(args)...);
-        auto last = tail_->prev->ptr;
-        link(last, node);
-        link(node, tail_);
-        ++size_;
-        return node->value;
-    }
-
-    /// Add element to the end (copy)
-    void push_back(const T &value) { emplace_back(value); }
-
-    /// Add element to the end (move)
-    void push_back(T &&value) { emplace_back(std::move(value)); }
-
-    /**
-     * @brief Construct element in-place at the beginning.
-     * @param args Arguments forwarded to T's constructor
-     * @return Reference to the inserted element
-     */
-    template <typename... Args>
-    reference emplace_front(Args &&...args)
-    {
-        auto node = std::make_shared<Node>(std::forward<Args>(args)...);
-        auto first = head_->next->ptr;
-        link(head_, node);
-        link(node, first);
-        ++size_;
-        return node->value;
-    }
-
-    /// Add element to the beginning (copy)
-    void push_front(const T &value) { emplace_front(value); }
-
-    /// Add element to the beginning (move)
-    void push_front(T &&value) { emplace_front(std::move(value)); }
-
-    /// Remove the last element
-    void pop_back()
-    {
-        if (!empty())
-            erase(iterator(tail_->prev->ptr));
-    }
-
-    /// Remove the first element
-    void pop_front()
-    {
-        if (!empty())
-            erase(begin());
-    }
-
-    /**
-     * @brief Erase element at iterator position.
-     *
-     * **SAFE DURING ITERATION**: This operation updates Ref wrapper contents
-     * rather than reassigning pointers. The predecessor's next Ref now points
-     * to the successor, so any iterator that was pointing to the erased node
-     * will correctly advance to the successor on the next increment.
-     *
-     * @param pos Iterator to the element to remove
-     * @return Iterator to the element following the removed element
-     *
-     * @code
-     *     for (auto it = list.begin(); it != list.end(); ++it) {
-     *         if (should_remove(*it)) {
-     *             list.erase(it);  // Just delete - iterator continues correctly!
-     *         }
-     *     }
-     * @endcode
-     */
-    iterator erase(iterator pos)
-    {
-        auto node = pos.node();
-        auto pred = node->prev->ptr;
-        auto succ = node->next->ptr;
-        // CRITICAL: Update Ref CONTENTS, not reassign pointers
-        // This is what enables safe deletion during iteration
-        pred->next->ptr = succ; // A->B->C becomes A->C
-        succ->prev->ptr = pred; // C's prev updated from B to A
-        --size_;
-        return iterator(succ);
-    }
-
-    /**
-     * @brief Erase element by node pointer (alternative API).
-     *
-     * Can be used when you have direct access to the node rather than
-     * an iterator. Also safe during iteration.
-     *
-     * @param node The node to remove
-     */
-    void erase_node(const NodePtr &node)
-    {
-        auto pred = node->prev->ptr;
-        auto succ = node->next->ptr;
-        pred->next->ptr = succ;
-        succ->prev->ptr = pred;
-        --size_;
-    }
-};
-
-/// Free function swap for ADL (Argument-Dependent Lookup)
-template <typename T, typename A>
-void swap(MutableList<T, A> &a, MutableList<T, A> &b) noexcept { a.swap(b); }
+#include <string>
+#include <thread>
 
 // ============================================================================
 // EXAMPLE USAGE
@@ -557,4 +87,203 @@ int main()
     for (int n : numbers)
         std::cout << n << ' ';
     std::cout << '\n';
+
+    // Bulk erase: runs of matches are unlinked in one step each
+    numbers.erase_if([](int n) { return n % 2 != 0; });
+    std::cout << "Even: ";
+    for (int n : numbers)
+        std::cout << n << ' ';
+    std::cout << '\n';
+
+    // Splice: relink nodes from another list without copying them
+    MutableList<int> more{6, 8};
+    numbers.splice(numbers.end(), more);
+    std::cout << "Spliced: ";
+    for (int n : numbers)
+        std::cout << n << ' ';
+    std::cout << "(other list now has " << more.size() << ")\n";
+
+    // Ordering: insert, sort and merge relink nodes instead of copying them
+    MutableList<int> stamps{30, 10, 50};
+    stamps.insert(std::next(stamps.begin()), 20);
+    stamps.sort();
+    stamps.merge(MutableList<int>{15, 40});
+    std::cout << "Sorted: ";
+    for (int n : stamps)
+        std::cout << n << ' ';
+    std::cout << '\n';
+
+    // Lazy views: filter, transform and take without building intermediate lists
+    std::cout << "Views:";
+    for (int n : stamps | filtered([](int n) { return n % 20 != 0; }) |
+                     transformed([](int n) { return n / 5; }) | taken(3))
+        std::cout << ' ' << n;
+    auto late = stamps | filtered([](int n) { return n >= 40; });
+    for (auto it = late.begin(); it != late.end(); ++it)
+        late.erase(it); // Erase through the view; it keeps stepping
+    std::cout << " (" << stamps.size() << " left after erasing through a view)\n";
+
+    // Multi-chain: one allocation per element, linked into an LRU order and an insertion order
+    MultiMutableList<std::string, 2> cache;
+    auto *oldest = cache.emplace_back("a");
+    cache.emplace_back("b");
+    auto *third = cache.emplace_back("c");
+    cache.chain<0>().move_to_front(third); // Touch "c": only the LRU order changes
+    auto lru = cache.chain<0>();
+    for (auto it = lru.begin(); it != lru.end(); ++it)
+    {
+        if (it.node() == oldest)
+            cache.erase(it); // Leaves both chains; it keeps stepping
+    }
+    std::cout << "Multi-chain: LRU";
+    for (const auto &key : cache.chain<0>())
+        std::cout << ' ' << key;
+    std::cout << ", insertion order";
+    for (const auto &key : cache.chain<1>())
+        std::cout << ' ' << key;
+    std::cout << '\n';
+
+    // LRU cache: a hit relinks the entry to the front without allocating
+    LruCache<int, std::string> recent(3);
+    for (int id = 1; id <= 3; ++id)
+        recent.put(id, "page" + std::to_string(id));
+    recent.get(1);             // Hit: 1 is now the most recent
+    recent.put(4, "page4");    // Evicts 2, the least recent
+    recent.get(2);             // Miss
+    std::cout << "LRU:";
+    for (const auto &entry : recent)
+        std::cout << ' ' << entry.first;
+    std::cout << " (" << recent.stats().hits << " hit, " << recent.stats().misses << " miss, "
+              << recent.stats().evictions << " eviction)\n";
+
+    // Locality: compact() reallocates the nodes in traversal order (it refuses while iterators exist)
+    MutableList<int> churned{5, 3, 8, 1, 9, 2};
+    churned.sort(); // Relinks nodes: traversal order no longer follows addresses
+    bool compacted = churned.compact();
+    int churnedSum = 0;
+    churned.for_each([&churnedSum](int n) { churnedSum += n; });
+    std::cout << "Compacted: " << (compacted ? "yes" : "no") << ", sum " << churnedSum << '\n';
+
+#ifdef MUTABLE_CHAIN_COROUTINES
+    // Coroutine traversal: suspended between batches, resumes past erasures
+    MutableList<int> feed{1, 2, 3, 4, 5, 6, 7};
+    std::cout << "Batches:";
+    for (const auto &batch : batches(feed, 3))
+    {
+        std::cout << " [";
+        for (int *n : batch)
+            std::cout << ' ' << *n;
+        std::cout << " ]";
+        feed.erase_if([](int n) { return n == 4 || n == 5; }); // While suspended
+    }
+    std::cout << '\n';
+#endif
+
+    // Pool-backed list: nodes come from a per-list free-list pool
+    MutableList<int, PoolAllocator<int>> pooled{10, 20, 30};
+    pooled.pop_front();
+    pooled.push_back(40); // Reuses the block freed by pop_front
+    std::cout << "Pooled: ";
+    for (int n : pooled)
+        std::cout << n << ' ';
+    std::cout << '\n';
+
+    // Chunked list: values packed 64 to a chunk, same erase-while-iterating contract
+    ChunkedMutableList<int> chunked;
+    for (int n = 0; n < 200; ++n)
+        chunked.push_back(n);
+    for (auto it = chunked.begin(); it != chunked.end(); ++it)
+    {
+        if (*it % 50 != 0)
+            chunked.erase(it);
+    }
+    std::cout << "Chunked: ";
+    chunked.for_each([](int n) { std::cout << n << ' '; });
+    std::cout << '\n';
+
+    // Concurrent list: one thread appends while another erases mid-iteration
+    ConcurrentMutableList<int> shared;
+    std::atomic<bool> producing{true};
+    std::thread producer([&] {
+        for (int n = 1; n <= 1000; ++n)
+            shared.push_back(n);
+        producing = false;
+    });
+    auto isEven = [](int n) { return n % 2 == 0; };
+    while (producing)
+        shared.erase_if(isEven);
+    producer.join();
+    shared.erase_if(isEven);
+    std::cout << "Concurrent: " << shared.size() << " odd values left\n";
+
+    // MPSC queue: producers append with one atomic exchange, the consumer cancels and pops
+    MpscMutableQueue<int> work;
+    std::thread workers[2];
+    for (int w = 0; w < 2; ++w)
+    {
+        workers[w] = std::thread([&work, w] {
+            for (int n = 0; n < 500; ++n)
+                work.push_back(w * 500 + n);
+        });
+    }
+    for (std::thread &worker : workers)
+        worker.join();
+    work.erase_if([](int n) { return n % 100 != 0; });
+    int job, popped = 0;
+    while (work.try_pop_front(job))
+        ++popped;
+    std::cout << "Queue: " << popped << " jobs left after cancellation\n";
+
+    // Parallel traversal: segments run on a work-stealing pool, erasures are deferred
+    MutableList<int> big;
+    for (int n = 0; n < 100000; ++n)
+        big.push_back(n);
+    WorkStealingPool pool(4);
+    parallel_for_each(
+        big,
+        [](int &n, EraseHandle &current) {
+            if (n % 10 != 0)
+                current.erase();
+        },
+        pool);
+    std::cout << "Parallel: " << big.size() << " multiples of 10 kept\n";
+
+    // Versioned list: a snapshot keeps its view while the writer carries on
+    VersionedMutableList<int> ledger{1, 2, 3};
+    auto report = ledger.snapshot();
+    ledger.push_back(4);
+    ledger.erase(ledger.begin());
+    int reported = 0;
+    report.for_each([&](int n) { reported += n; });
+    std::cout << "Versioned: snapshot sum " << reported << ", live size " << ledger.size() << '\n';
+
+    // Indexed list: O(1) lookup and erase by value, even mid-iteration
+    IndexedMutableList<int> orders{101, 102, 103, 104, 105};
+    for (auto it = orders.begin(); it != orders.end(); ++it)
+    {
+        if (*it == 102)
+            orders.erase(104); // Erase a later element by value while iterating
+    }
+    orders.erase(orders.find(101));
+    std::cout << "Indexed: ";
+    for (int id : orders)
+        std::cout << id << ' ';
+    std::cout << "(contains 104: " << std::boolalpha << orders.contains(104) << ")\n";
+
+    // Handles: 8-byte (index, generation) references that detect erased elements
+    HandleMutableList<std::string> jobs;
+    ListHandle first = jobs.push_back("compile");
+    ListHandle second = jobs.push_back("link");
+    jobs.erase(first);
+    std::cout << "Handles: first " << (jobs.contains(first) ? "live" : "stale") << ", second -> "
+              << *jobs.get(second) << '\n';
+
+    // Checkpoint/restore: save a snapshot, then reload it or scan it in place
+    save(big, "mutable_chain_demo.chain");
+    MutableList<int> restored = load<int>("mutable_chain_demo.chain");
+    long long total = 0;
+    for (int n : MappedChainView<int>("mutable_chain_demo.chain"))
+        total += n;
+    std::remove("mutable_chain_demo.chain");
+    std::cout << "Snapshot: " << restored.size() << " values restored, mapped sum " << total << '\n';
 }
@@ -0,0 +1,143 @@
+/*
+ * List-Wrapper Based Reference Management Pattern - C Interface
+ *
+ * Declarations for the chain implemented in mutable_chain.c. See that file
+ * for the full explanation of the wrapper indirection technique.
+ *
+ * Usable from C++ as well (declarations are wrapped in extern "C").
+ */
+
+#ifndef MUTABLE_CHAIN_H
+#define MUTABLE_CHAIN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Forward declarations */
+typedef struct NodeWrapper NodeWrapper;
+typedef struct Node Node;
+
+/* Wrapper structure - the indirection layer */
+struct NodeWrapper {
+    Node *node;
+};
+
+/* Node structure - represents data in the chain */
+struct Node {
+    NodeWrapper *to;       /* Forward reference wrapper */
+    NodeWrapper *from;     /* Backward reference wrapper */
+    char *data;            /* Node data (NULL for terminal/initial) */
+    bool is_initial;       /* Flag for initial node */
+    bool is_terminal;      /* Flag for terminal node */
+};
+
+/* Create a new wrapper pointing to a node */
+NodeWrapper* create_wrapper(Node *node);
+
+/* Create a new node holding a private copy of data (may be NULL) */
+Node* create_node(const char *data);
+
+/* Create the initial (head) and terminal (tail) marker nodes */
+Node* create_initial_node(void);
+Node* create_terminal_node(void);
+
+/* Link a_link -> a_data in both directions with fresh wrappers */
+void link_to_and_from(Node *a_link, Node *a_data);
+
+/* Unlink a_link by updating its neighbours' wrapper contents */
+void link_data_remove(Node *a_link);
+
+/* Visit every node after a_link (or before it, if reverse) */
+void link_iterator(Node *a_link, bool reverse, void (*callback)(Node*, void*), void *user_data);
+
+/* Free a node, its data and the wrappers it owns */
+void free_node(Node *node);
+
+/* ----------------------------------------------------------------------------
+ * Inline iteration
+ *
+ * Cursor and macro forms of link_iterator. The loop body is ordinary code
+ * in the caller, so the compiler can inline and optimize it; each step is
+ * one wrapper load and one flag test. Semantics match link_iterator: the
+ * node just visited may be removed with link_data_remove, and the next step
+ * follows its (still intact) wrapper to the successor.
+ *
+ *     CHAIN_FOREACH(node, initial) {
+ *         if (should_delete(node))
+ *             link_data_remove(node);   // Safe, iteration continues
+ *     }
+ * ------------------------------------------------------------------------- */
+
+typedef struct ChainCursor ChainCursor;
+
+struct ChainCursor {
+    Node *current;         /* Node most recently returned (or the start node) */
+    bool reverse;          /* Follow "from" wrappers instead of "to" wrappers */
+};
+
+/* Start a cursor that will visit the nodes after a_link (or before it, if reverse) */
+static inline ChainCursor chain_cursor_begin(Node *a_link, bool reverse) {
+    ChainCursor cursor;
+    cursor.current = a_link;
+    cursor.reverse = reverse;
+    return cursor;
+}
+
+/* Advance and return the next node, or NULL at the terminal (initial) node */
+static inline Node* chain_cursor_next(ChainCursor *cursor) {
+    Node *next_node = cursor->reverse ? cursor->current->from->node : cursor->current->to->node;
+    if (cursor->reverse ? next_node->is_initial : next_node->is_terminal) {
+        return NULL;
+    }
+    cursor->current = next_node;
+    return next_node;
+}
+
+/* Loop over every node after a_link; node is declared by the macro */
+#define CHAIN_FOREACH(node, a_link) \
+    for (Node *node = (a_link)->to->node; !node->is_terminal; node = node->to->node)
+
+/* Loop over every node before a_link, walking "from" wrappers */
+#define CHAIN_FOREACH_REVERSE(node, a_link) \
+    for (Node *node = (a_link)->from->node; !node->is_initial; node = node->from->node)
+
+/* ----------------------------------------------------------------------------
+ * Arena-backed chains
+ *
+ * A ChainArena carves nodes, their two wrappers and an inline copy of their
+ * data from large blocks, one bump-pointer step per node. Arena nodes are
+ * linked with chain_arena_link (which fills the node's own wrappers instead
+ * of allocating new ones) and are never passed to free_node: the whole chain
+ * goes at once with chain_arena_reset or chain_arena_destroy.
+ * ------------------------------------------------------------------------- */
+
+typedef struct ChainArena ChainArena;
+
+/* Create an arena carving blocks of block_size bytes (0 picks a default) */
+ChainArena* chain_arena_create(size_t block_size);
+
+/* Create a node with pre-carved wrappers and an inline copy of data (may be NULL) */
+Node* chain_arena_node(ChainArena *arena, const char *data);
+
+/* Arena versions of create_initial_node / create_terminal_node */
+Node* chain_arena_initial_node(ChainArena *arena);
+Node* chain_arena_terminal_node(ChainArena *arena);
+
+/* Link a_link -> a_data in both directions by filling their own wrappers */
+void chain_arena_link(Node *a_link, Node *a_data);
+
+/* Drop every node in O(1), keeping the blocks for the next chain */
+void chain_arena_reset(ChainArena *arena);
+
+/* Free the arena and every node carved from it */
+void chain_arena_destroy(ChainArena *arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MUTABLE_CHAIN_H */
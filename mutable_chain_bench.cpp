@@ -0,0 +1,1666 @@
+/**
+ * @file mutable_chain_bench.cpp
+ * @brief Google Benchmark suite for MutableList<T> and the C chain
+ *
+ * Compares MutableList (and its chunked variant, ChunkedMutableList) against
+ * std::list, std::vector (erase-remove) and the C link_iterator /
+ * link_data_remove path on the operations the pattern is
+ * built for:
+ *
+ * - stable sort (two passes per iteration) against std::list::sort and std::stable_sort
+ * - millions-of-tiny-lists workloads: 0 to 4 elements per list, against std::list and std::vector
+ * - push_back / push_front, push_back_bulk and Batch append, copy construction and copy assignment, and C chain build + teardown with malloc vs ChainArena
+ * - full forward traversal and reverse traversal (plus the chunked for_each, and the
+ *   batches() coroutine in MUTABLE_CHAIN_ENABLE_COROUTINES builds)
+ * - erase during iteration at delete ratios of 10%, 50% and 90%
+ * - bulk erase_if / remove_if at the same ratios, and chunked threshold filters
+ *   with a lambda against the vectorized less_than() predicate
+ * - shared scans with element churn from 1, 2 and 4 threads:
+ *   ConcurrentMutableList against a mutex-guarded MutableList
+ * - work-queue throughput from 1 to 16 producer threads: MpscMutableQueue
+ *   against a mutex-guarded MutableList
+ * - parallel_for_each on 1 to 8 pool workers against a serial loop
+ * - snapshot save, load and in-place scan of a memory-mapped snapshot
+ * - the cost of the CountingListStats policy (CountedList rows)
+ * - targeted erase by value: MutableList scan against IndexedMutableList
+ * - erase through stored references: HandleMutableList handles against raw nodes
+ * - consistent reports under writes: VersionedMutableList snapshots against deep copies
+ * - query pipelines (filter, transform, take k): lazy views against a MutableList per stage
+ * - one element in three orders (touch, evict, re-insert): MultiMutableList against three MutableLists
+ * - LRU cache hits: LruCache move_to_front against erase + push_front
+ * - scans of a churned (address-scattered) list: plain, prefetching for_each (no faster), and after compact()
+ *
+ * Every benchmark reports @c per_op (time per element) and @c bytes_per_elem
+ * (container-owned heap bytes per element, measured with a counting
+ * allocator; for the C chain, the sum of its malloc request sizes).
+ *
+ * @code
+ *     ./bin/mutable_chain_bench --benchmark_filter=Erase
+ * @endcode
+ */
+
+#include "mutable_chain.h"
+#include "mutable_chain.hpp"
+#include "mutable_chain_chunked.hpp"
+#include "mutable_chain_concurrent.hpp"
+#include "mutable_chain_handles.hpp"
+#include "mutable_chain_indexed.hpp"
+#include "mutable_chain_io.hpp"
+#include "mutable_chain_lru.hpp"
+#include "mutable_chain_multi.hpp"
+#include "mutable_chain_parallel.hpp"
+#include "mutable_chain_queue.hpp"
+#include "mutable_chain_versioned.hpp"
+#include "mutable_chain_views.hpp"
+
+#ifdef MUTABLE_CHAIN_COROUTINES
+#include "mutable_chain_coro.hpp"
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+
+// ============================================================================
+// MEASUREMENT HELPERS
+// ============================================================================
+
+/// Heap bytes currently held through CountingAllocator
+std::size_t g_counted_bytes = 0;
+
+/**
+ * @brief Stateless allocator that tallies live bytes in g_counted_bytes.
+ *
+ * Only used to measure footprint; timed runs use std::allocator.
+ */
+template <typename T>
+struct CountingAllocator
+{
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U> &) noexcept
+    {
+    }
+
+    T *allocate(std::size_t n)
+    {
+        g_counted_bytes += n * sizeof(T);
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T *p, std::size_t n) noexcept
+    {
+        g_counted_bytes -= n * sizeof(T);
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U> &) const { return true; }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U> &) const { return false; }
+};
+
+template <typename T>
+T makeValue(std::size_t i);
+
+template <>
+int makeValue<int>(std::size_t i)
+{
+    return static_cast<int>(i);
+}
+
+template <>
+float makeValue<float>(std::size_t i)
+{
+    return static_cast<float>(i);
+}
+
+template <>
+std::string makeValue<std::string>(std::size_t i)
+{
+    return "item" + std::to_string(i);
+}
+
+/// Deterministic erase mask: roughly @p percent of positions are marked
+std::vector<bool> makeEraseMask(std::size_t n, int percent)
+{
+    std::vector<bool> mask(n);
+    std::uint32_t x = 2463534242u;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        mask[i] = static_cast<int>(x % 100) < percent;
+    }
+    return mask;
+}
+
+/// ChunkedMutableList with its default chunk size, in (T, Allocator) form
+template <typename T, typename A>
+using ChunkedList = ChunkedMutableList<T, A>;
+
+/// MutableList with the CountingListStats policy, to measure its overhead
+template <typename T, typename A>
+using CountedList = MutableList<T, A, CountingListStats>;
+
+/// IndexedMutableList with std::hash / std::equal_to, in (T, Allocator) form
+template <typename T, typename A>
+using IndexedList = IndexedMutableList<T, std::hash<T>, std::equal_to<T>, A>;
+
+template <template <typename, typename...> class Container, typename T>
+Container<T, std::allocator<T>> makeContainer(std::size_t n)
+{
+    Container<T, std::allocator<T>> c;
+    for (std::size_t i = 0; i < n; ++i)
+        c.push_back(makeValue<T>(i));
+    return c;
+}
+
+/// Record time per element and heap bytes per element for @p n elements
+template <template <typename, typename...> class Container, typename T>
+void setCounters(benchmark::State &state, std::size_t n)
+{
+    std::size_t before = g_counted_bytes;
+    {
+        Container<T, CountingAllocator<T>> c;
+        for (std::size_t i = 0; i < n; ++i)
+            c.push_back(makeValue<T>(i));
+        state.counters["bytes_per_elem"] =
+            static_cast<double>(g_counted_bytes - before) / static_cast<double>(n);
+    }
+    state.counters["per_op"] = benchmark::Counter(
+        static_cast<double>(n),
+        benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+// ============================================================================
+// ERASE DURING ITERATION (one overload per container idiom)
+// ============================================================================
+
+/// MutableList: erase the current element and keep stepping from it
+template <typename T, typename A, typename S>
+void eraseMarked(MutableList<T, A, S> &c, const std::vector<bool> &mask)
+{
+    std::size_t i = 0;
+    for (auto it = c.begin(); it != c.end(); ++it)
+    {
+        if (mask[i++])
+            c.erase(it);
+    }
+}
+
+/// ChunkedMutableList: same idiom as MutableList
+template <typename T, typename A, std::size_t N>
+void eraseMarked(ChunkedMutableList<T, A, N> &c, const std::vector<bool> &mask)
+{
+    std::size_t i = 0;
+    for (auto it = c.begin(); it != c.end(); ++it)
+    {
+        if (mask[i++])
+            c.erase(it);
+    }
+}
+
+/// std::list: continue from the iterator returned by erase
+template <typename T, typename A>
+void eraseMarked(std::list<T, A> &c, const std::vector<bool> &mask)
+{
+    std::size_t i = 0;
+    for (auto it = c.begin(); it != c.end();)
+    {
+        if (mask[i++])
+            it = c.erase(it);
+        else
+            ++it;
+    }
+}
+
+/// std::vector: the erase-remove idiom
+template <typename T, typename A>
+void eraseMarked(std::vector<T, A> &c, const std::vector<bool> &mask)
+{
+    std::size_t i = 0;
+    auto out = c.begin();
+    for (auto it = c.begin(); it != c.end(); ++it)
+    {
+        if (!mask[i++])
+            *out++ = std::move(*it);
+    }
+    c.erase(out, c.end());
+}
+
+// ============================================================================
+// C++ CONTAINER BENCHMARKS
+// ============================================================================
+
+template <template <typename, typename...> class Container, typename T>
+void BM_PushBack(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        Container<T, std::allocator<T>> c;
+        for (std::size_t i = 0; i < n; ++i)
+            c.push_back(makeValue<T>(i));
+        benchmark::DoNotOptimize(c);
+    }
+    setCounters<Container, T>(state, n);
+}
+
+/// Fill @p lists with containers of 0 to 4 elements each (list i holds i % 5)
+template <typename C>
+void fillSmallLists(std::vector<C> &lists, std::size_t n)
+{
+    lists.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        lists.emplace_back();
+        for (std::size_t k = 0; k < i % 5; ++k)
+            lists.back().push_back(makeValue<typename C::value_type>(k));
+    }
+}
+
+/// Build and drop n tiny containers (one per entity); per_op and bytes_per_elem are per list
+template <template <typename, typename...> class Container, typename T>
+void BM_SmallLists(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        std::vector<Container<T, std::allocator<T>>> lists;
+        fillSmallLists(lists, n);
+        benchmark::DoNotOptimize(lists.data());
+    }
+    std::size_t before = g_counted_bytes;
+    {
+        std::vector<Container<T, CountingAllocator<T>>> lists;
+        fillSmallLists(lists, n);
+        state.counters["bytes_per_elem"] =
+            static_cast<double>(g_counted_bytes - before + lists.size() * sizeof(lists[0])) /
+            static_cast<double>(n);
+    }
+    state.counters["per_op"] = benchmark::Counter(
+        static_cast<double>(n),
+        benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+/// Append n values as one pre-built chain (two tail relinks in total)
+template <typename T>
+void BM_PushBackBulk(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::vector<T> source;
+    for (std::size_t i = 0; i < n; ++i)
+        source.push_back(makeValue<T>(i));
+    for (auto _ : state)
+    {
+        MutableList<T> c;
+        c.push_back_bulk(source.begin(), source.end());
+        benchmark::DoNotOptimize(c);
+    }
+    setCounters<MutableList, T>(state, n);
+}
+
+/// Fill a detached Batch, then attach it to the list in O(1)
+template <typename T>
+void BM_BatchAppend(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        MutableList<T> c;
+        auto batch = c.make_batch();
+        for (std::size_t i = 0; i < n; ++i)
+            batch.push_back(makeValue<T>(i));
+        c.append(std::move(batch));
+        benchmark::DoNotOptimize(c);
+    }
+    setCounters<MutableList, T>(state, n);
+}
+
+/// Clone a list: copy construction of a fresh container
+template <template <typename, typename...> class Container, typename T>
+void BM_CopyConstruct(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto source = makeContainer<Container, T>(n);
+    for (auto _ : state)
+    {
+        Container<T, std::allocator<T>> copy(source);
+        benchmark::DoNotOptimize(copy);
+    }
+    setCounters<Container, T>(state, n);
+}
+
+/// Re-snapshot into an existing list of the same size (node reuse)
+template <template <typename, typename...> class Container, typename T>
+void BM_CopyAssign(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto source = makeContainer<Container, T>(n);
+    auto target = makeContainer<Container, T>(n);
+    for (auto _ : state)
+    {
+        target = source;
+        benchmark::DoNotOptimize(target);
+    }
+    setCounters<Container, T>(state, n);
+}
+
+// ============================================================================
+// SORT
+// ============================================================================
+
+/// list-style containers sort by relinking
+template <typename C, typename Compare>
+void sortBy(C &c, Compare comp)
+{
+    c.sort(comp);
+}
+
+/// std::vector sorts by moving elements
+template <typename T, typename A, typename Compare>
+void sortBy(std::vector<T, A> &c, Compare comp)
+{
+    std::stable_sort(c.begin(), c.end(), comp);
+}
+
+/// Stable sort of n ints, alternating two unrelated orders so every pass sorts scrambled data
+template <template <typename, typename...> class Container>
+void BM_Sort(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto c = makeContainer<Container, int>(n);
+    auto byValue = [](int a, int b) { return a < b; };
+    auto byHash = [](int a, int b) {
+        return static_cast<std::uint32_t>(a) * 2654435761u < static_cast<std::uint32_t>(b) * 2654435761u;
+    };
+    for (auto _ : state)
+    {
+        sortBy(c, byHash);
+        sortBy(c, byValue);
+        benchmark::ClobberMemory();
+    }
+    setCounters<Container, int>(state, n);
+}
+
+template <template <typename, typename...> class Container, typename T>
+void BM_PushFront(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        Container<T, std::allocator<T>> c;
+        for (std::size_t i = 0; i < n; ++i)
+            c.push_front(makeValue<T>(i));
+        benchmark::DoNotOptimize(c);
+    }
+    setCounters<Container, T>(state, n);
+}
+
+/// std::vector has no push_front; insert at begin() is the equivalent
+template <typename T>
+void BM_VectorPushFront(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        std::vector<T> c;
+        for (std::size_t i = 0; i < n; ++i)
+            c.insert(c.begin(), makeValue<T>(i));
+        benchmark::DoNotOptimize(c);
+    }
+    setCounters<std::vector, T>(state, n);
+}
+
+template <template <typename, typename...> class Container, typename T>
+void BM_Traverse(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto c = makeContainer<Container, T>(n);
+    for (auto _ : state)
+    {
+        for (const auto &v : c)
+            benchmark::DoNotOptimize(&v);
+    }
+    setCounters<Container, T>(state, n);
+}
+
+#ifdef MUTABLE_CHAIN_COROUTINES
+/// MutableList traversal through the batches() coroutine (256 elements per resume)
+template <typename T>
+void BM_CoroBatches(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto c = makeContainer<MutableList, T>(n);
+    for (auto _ : state)
+    {
+        for (const auto &batch : batches(c, 256))
+        {
+            for (T *v : batch)
+                benchmark::DoNotOptimize(v);
+        }
+    }
+    setCounters<MutableList, T>(state, n);
+}
+#endif
+
+/// ChunkedMutableList::for_each: the per-chunk bitmap scan
+template <typename T>
+void BM_ChunkedForEach(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto c = makeContainer<ChunkedList, T>(n);
+    for (auto _ : state)
+        c.for_each([](const T &v) { benchmark::DoNotOptimize(&v); });
+    setCounters<ChunkedList, T>(state, n);
+}
+
+/// ChunkedMutableList::for_each over churned chunks: every third value erased, so each
+/// chunk is a series of two-slot runs separated by holes
+template <typename T>
+void BM_ChunkedSparseForEach(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto c = makeContainer<ChunkedList, T>(n);
+    std::size_t i = 0;
+    c.erase_if([&i](const T &) { return i++ % 3 == 2; });
+    for (auto _ : state)
+        c.for_each([](const T &v) { benchmark::DoNotOptimize(&v); });
+    setCounters<ChunkedList, T>(state, c.size());
+}
+
+template <template <typename, typename...> class Container, typename T>
+void BM_ReverseTraverse(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto c = makeContainer<Container, T>(n);
+    for (auto _ : state)
+    {
+        for (auto it = c.rbegin(); it != c.rend(); ++it)
+            benchmark::DoNotOptimize(&*it);
+    }
+    setCounters<Container, T>(state, n);
+}
+
+template <template <typename, typename...> class Container, typename T>
+void BM_EraseDuringIteration(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto mask = makeEraseMask(n, static_cast<int>(state.range(1)));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto c = makeContainer<Container, T>(n);
+        state.ResumeTiming();
+        eraseMarked(c, mask);
+        benchmark::DoNotOptimize(c);
+        state.PauseTiming();
+        c = decltype(c)(); // Teardown is not part of the erase pass
+        state.ResumeTiming();
+    }
+    setCounters<Container, T>(state, n);
+}
+
+/// Bulk removal of the same marked positions through each container's own API
+template <typename T, typename A, typename S>
+void eraseMarkedBulk(MutableList<T, A, S> &c, const std::vector<bool> &mask)
+{
+    std::size_t i = 0;
+    c.erase_if([&](const T &) { return mask[i++]; });
+}
+
+template <typename T, typename A, std::size_t N>
+void eraseMarkedBulk(ChunkedMutableList<T, A, N> &c, const std::vector<bool> &mask)
+{
+    std::size_t i = 0;
+    c.erase_if([&](const T &) { return mask[i++]; });
+}
+
+template <typename T, typename A>
+void eraseMarkedBulk(std::list<T, A> &c, const std::vector<bool> &mask)
+{
+    std::size_t i = 0;
+    c.remove_if([&](const T &) { return mask[i++]; });
+}
+
+template <template <typename, typename...> class Container, typename T>
+void BM_EraseIf(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto mask = makeEraseMask(n, static_cast<int>(state.range(1)));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto c = makeContainer<Container, T>(n);
+        state.ResumeTiming();
+        eraseMarkedBulk(c, mask);
+        benchmark::DoNotOptimize(c);
+        state.PauseTiming();
+        c = decltype(c)();
+        state.ResumeTiming();
+    }
+    setCounters<Container, T>(state, n);
+}
+
+// ============================================================================
+// THRESHOLD FILTERS (vector kernels)
+// ============================================================================
+
+/// Predicate "v < bound" as a plain lambda (the chunk's bitmap is walked slot by slot)
+template <typename T>
+auto belowPredicate(T bound, std::false_type)
+{
+    return [bound](const T &v) { return v < bound; };
+}
+
+/// Predicate "v < bound" as less_than(), which ChunkedMutableList runs as a vector kernel
+template <typename T>
+ValueIs<T, ValueOp::Less> belowPredicate(T bound, std::true_type)
+{
+    return less_than(bound);
+}
+
+/// count_if(v < bound) over a ChunkedMutableList, half of the values matching
+template <typename T, bool Vectorized>
+void BM_ChunkedCountBelow(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto c = makeContainer<ChunkedList, T>(n);
+    const auto pred = belowPredicate(makeValue<T>(n / 2), std::integral_constant<bool, Vectorized>());
+    for (auto _ : state)
+        benchmark::DoNotOptimize(c.count_if(pred));
+    setCounters<ChunkedList, T>(state, n);
+}
+
+/// erase_if(v < bound) over a ChunkedMutableList at the given delete ratio
+template <typename T, bool Vectorized>
+void BM_ChunkedThresholdErase(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto bound = makeValue<T>(n * static_cast<std::size_t>(state.range(1)) / 100);
+    const auto pred = belowPredicate(bound, std::integral_constant<bool, Vectorized>());
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto c = makeContainer<ChunkedList, T>(n);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(c.erase_if(pred));
+        state.PauseTiming();
+        c = decltype(c)();
+        state.ResumeTiming();
+    }
+    setCounters<ChunkedList, T>(state, n);
+}
+
+// ============================================================================
+// C CHAIN BENCHMARKS
+// ============================================================================
+
+/// A C chain: initial -> data... -> terminal, with its erased nodes on the side
+struct CChain
+{
+    Node *initial;
+    Node *terminal;
+    std::vector<Node *> removed;
+    std::size_t payload_bytes;
+};
+
+CChain buildCChain(std::size_t n)
+{
+    CChain chain{create_initial_node(), create_terminal_node(), {}, 0};
+    Node *last = chain.initial;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        std::string value = makeValue<std::string>(i);
+        Node *node = create_node(value.c_str());
+        chain.payload_bytes += value.size() + 1;
+        link_to_and_from(last, node);
+        last = node;
+    }
+    link_to_and_from(last, chain.terminal);
+    return chain;
+}
+
+void freeCChain(CChain &chain)
+{
+    for (Node *node = chain.initial; node;)
+    {
+        Node *next = node->is_terminal ? nullptr : node->to->node;
+        free_node(node);
+        node = next;
+    }
+    for (Node *node : chain.removed)
+        free_node(node);
+}
+
+void setCChainCounters(benchmark::State &state, std::size_t n)
+{
+    CChain chain = buildCChain(n);
+    const double bytes =
+        static_cast<double>(n * (sizeof(Node) + 2 * sizeof(NodeWrapper)) + chain.payload_bytes);
+    freeCChain(chain);
+    state.counters["bytes_per_elem"] = bytes / static_cast<double>(n);
+    state.counters["per_op"] = benchmark::Counter(
+        static_cast<double>(n),
+        benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+void BM_CChainPushBack(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        CChain chain = buildCChain(n);
+        benchmark::DoNotOptimize(chain.initial);
+        state.PauseTiming();
+        freeCChain(chain);
+        state.ResumeTiming();
+    }
+    setCChainCounters(state, n);
+}
+
+/// Build and free with malloc: the cost the arena removes
+void BM_CChainBuildTeardown(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        CChain chain = buildCChain(n);
+        benchmark::DoNotOptimize(chain.initial);
+        freeCChain(chain);
+    }
+    setCChainCounters(state, n);
+}
+
+/// Same chain carved from a ChainArena and dropped with chain_arena_reset
+void BM_CChainArenaBuildTeardown(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::vector<std::string> values;
+    for (std::size_t i = 0; i < n; ++i)
+        values.push_back(makeValue<std::string>(i));
+    ChainArena *arena = chain_arena_create(0);
+    for (auto _ : state)
+    {
+        Node *initial = chain_arena_initial_node(arena);
+        Node *last = initial;
+        for (const std::string &value : values)
+        {
+            Node *node = chain_arena_node(arena, value.c_str());
+            chain_arena_link(last, node);
+            last = node;
+        }
+        chain_arena_link(last, chain_arena_terminal_node(arena));
+        benchmark::DoNotOptimize(initial);
+        chain_arena_reset(arena);
+    }
+    chain_arena_destroy(arena);
+    setCChainCounters(state, n);
+}
+
+void visitNode(Node *node, void *user_data)
+{
+    benchmark::DoNotOptimize(node->data);
+    ++*static_cast<std::size_t *>(user_data);
+}
+
+void BM_CChainTraverse(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    CChain chain = buildCChain(n);
+    for (auto _ : state)
+    {
+        std::size_t visited = 0;
+        link_iterator(chain.initial, false, visitNode, &visited);
+        benchmark::DoNotOptimize(visited);
+    }
+    freeCChain(chain);
+    setCChainCounters(state, n);
+}
+
+void BM_CChainReverseTraverse(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    CChain chain = buildCChain(n);
+    for (auto _ : state)
+    {
+        std::size_t visited = 0;
+        link_iterator(chain.terminal, true, visitNode, &visited);
+        benchmark::DoNotOptimize(visited);
+    }
+    freeCChain(chain);
+    setCChainCounters(state, n);
+}
+
+/// CHAIN_FOREACH: same walk as BM_CChainTraverse with the body inlined
+void BM_CChainForEach(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    CChain chain = buildCChain(n);
+    for (auto _ : state)
+    {
+        std::size_t visited = 0;
+        CHAIN_FOREACH(node, chain.initial)
+        {
+            benchmark::DoNotOptimize(node->data);
+            ++visited;
+        }
+        benchmark::DoNotOptimize(visited);
+    }
+    freeCChain(chain);
+    setCChainCounters(state, n);
+}
+
+#ifdef MUTABLE_CHAIN_COROUTINES
+/// C chain traversal through the batches() coroutine (256 nodes per resume)
+void BM_CChainCoroBatches(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    CChain chain = buildCChain(n);
+    for (auto _ : state)
+    {
+        std::size_t visited = 0;
+        for (const auto &batch : batches(chain.initial, 256))
+        {
+            for (Node *node : batch)
+                benchmark::DoNotOptimize(node->data);
+            visited += batch.size();
+        }
+        benchmark::DoNotOptimize(visited);
+    }
+    freeCChain(chain);
+    setCChainCounters(state, n);
+}
+#endif
+
+/// Callback state for the C erase pass
+struct CEraseContext
+{
+    const std::vector<bool> *mask;
+    std::size_t index;
+    std::vector<Node *> *removed;
+};
+
+void removeMarked(Node *node, void *user_data)
+{
+    auto *ctx = static_cast<CEraseContext *>(user_data);
+    if ((*ctx->mask)[ctx->index++])
+    {
+        link_data_remove(node);
+        ctx->removed->push_back(node); // Freed after the pass, like the demo
+    }
+}
+
+void BM_CChainEraseDuringIteration(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto mask = makeEraseMask(n, static_cast<int>(state.range(1)));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        CChain chain = buildCChain(n);
+        chain.removed.reserve(n);
+        state.ResumeTiming();
+        CEraseContext ctx{&mask, 0, &chain.removed};
+        link_iterator(chain.initial, false, removeMarked, &ctx);
+        state.PauseTiming();
+        freeCChain(chain);
+        state.ResumeTiming();
+    }
+    setCChainCounters(state, n);
+}
+
+/// Erase during a CHAIN_FOREACH walk instead of a link_iterator callback
+void BM_CChainForEachErase(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto mask = makeEraseMask(n, static_cast<int>(state.range(1)));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        CChain chain = buildCChain(n);
+        chain.removed.reserve(n);
+        state.ResumeTiming();
+        std::size_t i = 0;
+        CHAIN_FOREACH(node, chain.initial)
+        {
+            if (mask[i++])
+            {
+                link_data_remove(node);
+                chain.removed.push_back(node);
+            }
+        }
+        state.PauseTiming();
+        freeCChain(chain);
+        state.ResumeTiming();
+    }
+    setCChainCounters(state, n);
+}
+
+// ============================================================================
+// CONCURRENT SCAN BENCHMARKS
+// ============================================================================
+
+/// Shared state for the threaded benchmarks; built and torn down by thread 0
+ConcurrentMutableList<int> *g_concurrent = nullptr;
+MutableList<int> *g_locked = nullptr;
+std::mutex g_locked_mutex;
+
+/// Every thread scans the shared list, then moves its front element to the back
+void BM_ConcurrentScan(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    if (state.thread_index() == 0)
+    {
+        g_concurrent = new ConcurrentMutableList<int>;
+        for (std::size_t i = 0; i < n; ++i)
+            g_concurrent->push_back(makeValue<int>(i));
+    }
+    for (auto _ : state)
+    {
+        long sum = 0;
+        g_concurrent->for_each([&sum](int v) { sum += v; });
+        benchmark::DoNotOptimize(sum);
+        int v;
+        if (g_concurrent->try_pop_front(v))
+            g_concurrent->push_back(v);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+    if (state.thread_index() == 0)
+    {
+        delete g_concurrent;
+        g_concurrent = nullptr;
+    }
+}
+
+/// Same workload with MutableList behind a single mutex
+void BM_LockedScan(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    if (state.thread_index() == 0)
+    {
+        g_locked = new MutableList<int>;
+        for (std::size_t i = 0; i < n; ++i)
+            g_locked->push_back(makeValue<int>(i));
+    }
+    for (auto _ : state)
+    {
+        std::lock_guard<std::mutex> lock(g_locked_mutex);
+        long sum = 0;
+        for (int v : *g_locked)
+            sum += v;
+        benchmark::DoNotOptimize(sum);
+        int v = g_locked->front();
+        g_locked->pop_front();
+        g_locked->push_back(v);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+    if (state.thread_index() == 0)
+    {
+        delete g_locked;
+        g_locked = nullptr;
+    }
+}
+
+// ============================================================================
+// WORK QUEUE BENCHMARKS
+// ============================================================================
+
+MpscMutableQueue<int> *g_queue = nullptr;
+MutableList<int> *g_locked_queue = nullptr;
+std::mutex g_locked_queue_mutex;
+
+/// Every thread produces one element per iteration; thread 0 also consumes
+void BM_MpscQueue(benchmark::State &state)
+{
+    if (state.thread_index() == 0)
+        g_queue = new MpscMutableQueue<int>;
+    int n = 0;
+    for (auto _ : state)
+    {
+        g_queue->push_back(n++);
+        if (state.thread_index() == 0)
+        {
+            int v;
+            while (g_queue->try_pop_front(v))
+                benchmark::DoNotOptimize(v);
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+    if (state.thread_index() == 0)
+    {
+        delete g_queue;
+        g_queue = nullptr;
+    }
+}
+
+/// Same workload with MutableList behind a single mutex
+void BM_LockedQueue(benchmark::State &state)
+{
+    if (state.thread_index() == 0)
+        g_locked_queue = new MutableList<int>;
+    int n = 0;
+    for (auto _ : state)
+    {
+        std::lock_guard<std::mutex> lock(g_locked_queue_mutex);
+        g_locked_queue->push_back(n++);
+        if (state.thread_index() == 0)
+        {
+            while (!g_locked_queue->empty())
+            {
+                benchmark::DoNotOptimize(g_locked_queue->front());
+                g_locked_queue->pop_front();
+            }
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+    if (state.thread_index() == 0)
+    {
+        delete g_locked_queue;
+        g_locked_queue = nullptr;
+    }
+}
+
+// ============================================================================
+// PARALLEL TRAVERSAL BENCHMARKS
+// ============================================================================
+
+/// Stand-in for per-element reprocessing work (a few dozen cycles)
+inline std::uint64_t mixValue(std::uint64_t x)
+{
+    for (int round = 0; round < 8; ++round)
+    {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+    }
+    return x;
+}
+
+/// Serial baseline for BM_ParallelForEach
+void BM_SerialForEach(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto list = makeContainer<MutableList, int>(n);
+    for (auto _ : state)
+    {
+        for (int &v : list)
+            v = static_cast<int>(mixValue(static_cast<std::uint64_t>(v)));
+        benchmark::ClobberMemory();
+    }
+    setCounters<MutableList, int>(state, n);
+}
+
+/// parallel_for_each on a pool of range(1) workers
+void BM_ParallelForEach(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto list = makeContainer<MutableList, int>(n);
+    WorkStealingPool pool(static_cast<unsigned>(state.range(1)));
+    for (auto _ : state)
+    {
+        parallel_for_each(
+            list, [](int &v) { v = static_cast<int>(mixValue(static_cast<std::uint64_t>(v))); },
+            pool);
+        benchmark::ClobberMemory();
+    }
+    setCounters<MutableList, int>(state, n);
+}
+
+// ============================================================================
+// ERASE BY VALUE
+// ============================================================================
+
+/// MutableList: scan for the value
+template <typename T, typename A>
+void eraseValue(MutableList<T, A> &c, const T &value)
+{
+    c.remove(value);
+}
+
+/// IndexedMutableList: one hash lookup
+template <typename T, typename A>
+void eraseValue(IndexedList<T, A> &c, const T &value)
+{
+    c.erase(value);
+}
+
+/// Erase one value chosen round robin, then append it again (size stays n)
+template <template <typename, typename...> class Container, typename T>
+void BM_EraseByValue(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto c = makeContainer<Container, T>(n);
+    std::size_t next = 0;
+    for (auto _ : state)
+    {
+        T value = makeValue<T>(next);
+        next = (next + 7919) % n; // Spread targets over the whole list
+        eraseValue(c, value);
+        c.push_back(std::move(value));
+    }
+    setCounters<Container, T>(state, n);
+    state.counters["per_op"] = benchmark::Counter(
+        1, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+// ============================================================================
+// ERASE THROUGH STORED REFERENCES
+// ============================================================================
+
+/// Raw node pointers kept outside the list (no staleness check possible)
+void BM_NodeEraseInsert(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    MutableList<int> list;
+    std::vector<ListNode<int> *> refs;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        list.push_back(static_cast<int>(i));
+        refs.push_back((--list.end()).node());
+    }
+    std::size_t next = 0;
+    for (auto _ : state)
+    {
+        list.erase_node(refs[next]);
+        list.push_back(static_cast<int>(next));
+        refs[next] = (--list.end()).node();
+        next = (next + 7919) % n;
+    }
+    setCounters<MutableList, int>(state, n);
+    state.counters["per_op"] = benchmark::Counter(
+        1, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+/// Generational handles kept outside the list (checked on every erase)
+void BM_HandleEraseInsert(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    HandleMutableList<int> list;
+    std::vector<ListHandle> refs;
+    for (std::size_t i = 0; i < n; ++i)
+        refs.push_back(list.push_back(static_cast<int>(i)));
+    std::size_t next = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(list.erase(refs[next]));
+        refs[next] = list.push_back(static_cast<int>(next));
+        next = (next + 7919) % n;
+    }
+    setCounters<HandleMutableList, int>(state, n);
+    state.counters["per_op"] = benchmark::Counter(
+        1, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+/// Snapshot file shared by the snapshot benchmarks (working directory)
+constexpr const char *kSnapshotPath = "mutable_chain_bench.chain";
+
+/// save() of a MutableList<int>
+void BM_SnapshotSave(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto list = makeContainer<MutableList, int>(n);
+    for (auto _ : state)
+        save(list, kSnapshotPath);
+    std::remove(kSnapshotPath);
+    setCounters<MutableList, int>(state, n);
+}
+
+/// load<int>() of a snapshot back into a MutableList<int>
+void BM_SnapshotLoad(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    save(makeContainer<MutableList, int>(n), kSnapshotPath);
+    for (auto _ : state)
+    {
+        auto list = load<int>(kSnapshotPath);
+        benchmark::DoNotOptimize(list);
+    }
+    std::remove(kSnapshotPath);
+    setCounters<MutableList, int>(state, n);
+}
+
+/// Full scan of a MappedChainView<int> (mapping set up once)
+void BM_MappedScan(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    save(makeContainer<MutableList, int>(n), kSnapshotPath);
+    MappedChainView<int> view(kSnapshotPath);
+    for (auto _ : state)
+    {
+        long long sum = 0;
+        for (int v : view)
+            sum += v;
+        benchmark::DoNotOptimize(sum);
+    }
+    std::remove(kSnapshotPath);
+    setCounters<MutableList, int>(state, n);
+}
+
+// ============================================================================
+// CONSISTENT REPORTS UNDER WRITES
+// ============================================================================
+
+/// One write, then a consistent scan from a deep copy of a MutableList<int>
+void BM_ReportCopy(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto list = makeContainer<MutableList, int>(n);
+    int next = static_cast<int>(n);
+    for (auto _ : state)
+    {
+        list.pop_front();
+        list.push_back(next++);
+        MutableList<int> copy(list);
+        long long sum = 0;
+        for (int v : copy)
+            sum += v;
+        benchmark::DoNotOptimize(sum);
+    }
+    setCounters<MutableList, int>(state, n);
+}
+
+/// One write, then a consistent scan of a VersionedMutableList<int> snapshot
+void BM_ReportSnapshot(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    VersionedMutableList<int> list; // Not movable: filled in place
+    for (std::size_t i = 0; i < n; ++i)
+        list.push_back(static_cast<int>(i));
+    int next = static_cast<int>(n);
+    for (auto _ : state)
+    {
+        list.erase(list.begin());
+        list.push_back(next++);
+        auto view = list.snapshot();
+        long long sum = 0;
+        for (int v : view)
+            sum += v;
+        benchmark::DoNotOptimize(sum);
+    }
+    setCounters<VersionedMutableList, int>(state, n);
+}
+
+// ============================================================================
+// QUERY PIPELINES
+// ============================================================================
+
+/// "keep multiples of 3, scale, take k" by building a MutableList per stage
+void BM_MaterializedPipeline(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto k = static_cast<std::size_t>(state.range(1));
+    const auto c = makeContainer<MutableList, int>(n);
+    for (auto _ : state)
+    {
+        MutableList<int> kept;
+        for (int v : c)
+        {
+            if (v % 3 == 0)
+                kept.push_back(v);
+        }
+        MutableList<int> scaled;
+        for (int v : kept)
+            scaled.push_back(v * 2);
+        long sum = 0;
+        std::size_t left = k;
+        for (auto it = scaled.begin(); it != scaled.end() && left > 0; ++it, --left)
+            sum += *it;
+        benchmark::DoNotOptimize(sum);
+    }
+    setCounters<MutableList, int>(state, n);
+}
+
+/// The same pipeline as lazy filtered | transformed | taken views
+void BM_LazyPipeline(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto k = static_cast<std::size_t>(state.range(1));
+    const auto c = makeContainer<MutableList, int>(n);
+    for (auto _ : state)
+    {
+        long sum = 0;
+        for (int v : c | filtered([](int v) { return v % 3 == 0; }) |
+                         transformed([](int v) { return v * 2; }) | taken(k))
+            sum += v;
+        benchmark::DoNotOptimize(sum);
+    }
+    setCounters<MutableList, int>(state, n);
+}
+
+// ============================================================================
+// ONE ELEMENT IN SEVERAL ORDERS
+// ============================================================================
+
+/// Orders each entry sits in (LRU, priority, owner list)
+constexpr std::size_t kOrders = 3;
+
+/// Three MutableList<std::string>s, one copy of the entry per order
+void BM_DuplicatedChains(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    using List = MutableList<std::string>;
+    List orders[kOrders];
+    std::vector<ListNode<std::string> *> refs(n * kOrders);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        for (std::size_t k = 0; k < kOrders; ++k)
+        {
+            orders[k].push_back(makeValue<std::string>(i));
+            refs[i * kOrders + k] = (--orders[k].end()).node();
+        }
+    }
+    std::size_t next = 0;
+    for (auto _ : state)
+    {
+        // Touch: move to the front of the LRU order
+        std::size_t touched = (next * 31) % n;
+        orders[0].splice(orders[0].begin(), orders[0], orders[0].iterator_to(refs[touched * kOrders]));
+        // Evict from every order, then re-insert
+        for (std::size_t k = 0; k < kOrders; ++k)
+        {
+            orders[k].erase_node(refs[next * kOrders + k]);
+            orders[k].push_back(makeValue<std::string>(next));
+            refs[next * kOrders + k] = (--orders[k].end()).node();
+        }
+        next = (next + 7919) % n;
+    }
+    std::size_t before = g_counted_bytes;
+    {
+        MutableList<std::string, CountingAllocator<std::string>> counted[kOrders];
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            for (auto &order : counted)
+                order.push_back(makeValue<std::string>(i));
+        }
+        state.counters["bytes_per_elem"] =
+            static_cast<double>(g_counted_bytes - before) / static_cast<double>(n);
+    }
+    state.counters["per_op"] = benchmark::Counter(
+        1, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+/// One MultiMutableList<std::string, 3> allocation per entry, linked into every order
+void BM_MultiChain(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    using List = MultiMutableList<std::string, kOrders>;
+    List entries; // Not movable: filled in place
+    std::vector<List::node_type *> refs(n);
+    for (std::size_t i = 0; i < n; ++i)
+        refs[i] = entries.emplace_back(makeValue<std::string>(i));
+    std::size_t next = 0;
+    for (auto _ : state)
+    {
+        entries.chain<0>().move_to_front(refs[(next * 31) % n]);
+        entries.erase(refs[next]);
+        refs[next] = entries.emplace_back(makeValue<std::string>(next));
+        next = (next + 7919) % n;
+    }
+    std::size_t before = g_counted_bytes;
+    {
+        MultiMutableList<std::string, kOrders, CountingAllocator<std::string>> counted;
+        for (std::size_t i = 0; i < n; ++i)
+            counted.emplace_back(makeValue<std::string>(i));
+        state.counters["bytes_per_elem"] =
+            static_cast<double>(g_counted_bytes - before) / static_cast<double>(n);
+    }
+    state.counters["per_op"] = benchmark::Counter(
+        1, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+// ============================================================================
+// LRU CACHE HITS
+// ============================================================================
+
+/// Hit emulated with erase + push_front on a MutableList plus an index (allocates per hit)
+void BM_LruEmulatedHit(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    MutableList<std::pair<int, std::string>> order;
+    std::unordered_map<int, ListNode<std::pair<int, std::string>> *> index;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        order.emplace_front(static_cast<int>(i), makeValue<std::string>(i));
+        index[static_cast<int>(i)] = order.begin().node();
+    }
+    std::size_t next = 0;
+    for (auto _ : state)
+    {
+        auto &slot = index.find(static_cast<int>(next))->second;
+        auto entry = std::move(slot->value);
+        order.erase_node(slot);
+        order.push_front(std::move(entry));
+        slot = order.begin().node();
+        benchmark::DoNotOptimize(slot->value.second.data());
+        next = (next + 7919) % n;
+    }
+    setCounters<MutableList, std::string>(state, n);
+    state.counters["per_op"] = benchmark::Counter(
+        1, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+/// LruCache::get: one lookup and an O(1) relink, no allocation
+void BM_LruCacheHit(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    LruCache<int, std::string> cache(n);
+    for (std::size_t i = 0; i < n; ++i)
+        cache.put(static_cast<int>(i), makeValue<std::string>(i));
+    std::size_t next = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cache.get(static_cast<int>(next))->data());
+        next = (next + 7919) % n;
+    }
+    setCounters<MutableList, std::string>(state, n);
+    state.counters["per_op"] = benchmark::Counter(
+        1, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+// ============================================================================
+// NODE LOCALITY
+// ============================================================================
+
+/**
+ * @brief A MutableList<int> whose traversal order is unrelated to its node addresses.
+ *
+ * Values are a shuffled permutation, then sorted: sort() relinks nodes, so
+ * each step of a scan lands on an arbitrary node, as after long churn.
+ */
+MutableList<int> makeScatteredList(std::size_t n)
+{
+    std::vector<int> order(n);
+    for (std::size_t i = 0; i < n; ++i)
+        order[i] = static_cast<int>(i);
+    std::uint32_t x = 2463534242u;
+    for (std::size_t i = n; i > 1; --i)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        std::swap(order[i - 1], order[x % i]);
+    }
+    MutableList<int> list(order.begin(), order.end());
+    list.sort();
+    return list;
+}
+
+/// Range-for scan of a scattered list
+void BM_ScatteredScan(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto list = makeScatteredList(n);
+    for (auto _ : state)
+    {
+        long sum = 0;
+        for (int v : list)
+            sum += v;
+        benchmark::DoNotOptimize(sum);
+    }
+    setCounters<MutableList, int>(state, n);
+}
+
+/// Prefetching for_each over the same scattered list
+void BM_ScatteredPrefetchScan(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto list = makeScatteredList(n);
+    for (auto _ : state)
+    {
+        long sum = 0;
+        list.for_each([&sum](int v) { sum += v; });
+        benchmark::DoNotOptimize(sum);
+    }
+    setCounters<MutableList, int>(state, n);
+}
+
+/// Per-element work for the scattered scans: about 200 dependent integer ops
+inline long scatteredWork(int v)
+{
+    auto x = static_cast<std::uint32_t>(v) | 1u;
+    for (int i = 0; i < 64; ++i)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+    }
+    return static_cast<long>(x);
+}
+
+/// Range-for scan of a scattered list, doing scatteredWork() per element
+void BM_ScatteredWorkScan(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto list = makeScatteredList(n);
+    for (auto _ : state)
+    {
+        long sum = 0;
+        for (int v : list)
+            sum += scatteredWork(v);
+        benchmark::DoNotOptimize(sum);
+    }
+    setCounters<MutableList, int>(state, n);
+}
+
+/// Prefetching for_each doing the same per-element work
+void BM_ScatteredPrefetchWorkScan(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto list = makeScatteredList(n);
+    for (auto _ : state)
+    {
+        long sum = 0;
+        list.for_each([&sum](int v) { sum += scatteredWork(v); });
+        benchmark::DoNotOptimize(sum);
+    }
+    setCounters<MutableList, int>(state, n);
+}
+
+/// Range-for scan of the scattered list after compact()
+void BM_CompactedScan(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    auto list = makeScatteredList(n);
+    if (!list.compact())
+        state.SkipWithError("compact() refused: the list is pinned");
+    for (auto _ : state)
+    {
+        long sum = 0;
+        for (int v : list)
+            sum += v;
+        benchmark::DoNotOptimize(sum);
+    }
+    setCounters<MutableList, int>(state, n);
+}
+
+/// compact() itself (the list is re-scattered outside the timed region)
+void BM_Compact(benchmark::State &state)
+{
+    const auto n = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto list = makeScatteredList(n);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(list.compact());
+        state.PauseTiming();
+        list.clear();
+        state.ResumeTiming();
+    }
+    setCounters<MutableList, int>(state, n);
+}
+
+// ============================================================================
+// REGISTRATION
+// ============================================================================
+
+constexpr std::int64_t kMinSize = 1 << 10;
+constexpr std::int64_t kMaxSize = 1 << 16;
+
+void sizes(benchmark::internal::Benchmark *b)
+{
+    b->RangeMultiplier(8)->Range(kMinSize, kMaxSize);
+}
+
+void sizesAndRatios(benchmark::internal::Benchmark *b)
+{
+    b->ArgsProduct({{kMinSize, kMaxSize}, {10, 50, 90}});
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_PushBack, MutableList, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_PushBack, MutableList, std::string)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_PushBack, CountedList, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_PushBackBulk, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_PushBackBulk, std::string)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_BatchAppend, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_BatchAppend, std::string)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_PushBack, ChunkedList, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_PushBack, ChunkedList, std::string)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_PushBack, std::list, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_PushBack, std::list, std::string)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_PushBack, std::vector, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_PushBack, std::vector, std::string)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_SmallLists, MutableList, int)->Arg(kMaxSize);
+BENCHMARK_TEMPLATE(BM_SmallLists, std::list, int)->Arg(kMaxSize);
+BENCHMARK_TEMPLATE(BM_SmallLists, std::vector, int)->Arg(kMaxSize);
+BENCHMARK(BM_CChainPushBack)->Apply(sizes);
+BENCHMARK(BM_CChainBuildTeardown)->Apply(sizes);
+BENCHMARK(BM_CChainArenaBuildTeardown)->Apply(sizes);
+
+BENCHMARK_TEMPLATE(BM_CopyConstruct, MutableList, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_CopyConstruct, MutableList, std::string)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_CopyConstruct, std::list, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_CopyConstruct, std::list, std::string)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_Sort, MutableList)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_Sort, std::list)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_Sort, std::vector)->Apply(sizes);
+
+BENCHMARK_TEMPLATE(BM_CopyAssign, MutableList, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_CopyAssign, MutableList, std::string)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_CopyAssign, std::list, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_CopyAssign, std::list, std::string)->Apply(sizes);
+
+BENCHMARK_TEMPLATE(BM_PushFront, MutableList, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_PushFront, MutableList, std::string)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_PushFront, ChunkedList, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_PushFront, ChunkedList, std::string)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_PushFront, std::list, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_PushFront, std::list, std::string)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_VectorPushFront, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_VectorPushFront, std::string)->Apply(sizes);
+
+BENCHMARK_TEMPLATE(BM_Traverse, MutableList, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_Traverse, MutableList, std::string)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_Traverse, CountedList, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_Traverse, ChunkedList, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_Traverse, ChunkedList, std::string)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_ChunkedForEach, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_ChunkedForEach, std::string)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_ChunkedSparseForEach, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_ChunkedSparseForEach, std::string)->Apply(sizes);
+#ifdef MUTABLE_CHAIN_COROUTINES
+BENCHMARK_TEMPLATE(BM_CoroBatches, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_CoroBatches, std::string)->Apply(sizes);
+#endif
+BENCHMARK_TEMPLATE(BM_Traverse, std::list, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_Traverse, std::list, std::string)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_Traverse, std::vector, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_Traverse, std::vector, std::string)->Apply(sizes);
+BENCHMARK(BM_CChainTraverse)->Apply(sizes);
+BENCHMARK(BM_CChainForEach)->Apply(sizes);
+#ifdef MUTABLE_CHAIN_COROUTINES
+BENCHMARK(BM_CChainCoroBatches)->Apply(sizes);
+#endif
+
+BENCHMARK_TEMPLATE(BM_ReverseTraverse, MutableList, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_ReverseTraverse, MutableList, std::string)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_ReverseTraverse, ChunkedList, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_ReverseTraverse, ChunkedList, std::string)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_ReverseTraverse, std::list, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_ReverseTraverse, std::list, std::string)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_ReverseTraverse, std::vector, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_ReverseTraverse, std::vector, std::string)->Apply(sizes);
+BENCHMARK(BM_CChainReverseTraverse)->Apply(sizes);
+
+BENCHMARK_TEMPLATE(BM_EraseDuringIteration, MutableList, int)->Apply(sizesAndRatios);
+BENCHMARK_TEMPLATE(BM_EraseDuringIteration, MutableList, std::string)->Apply(sizesAndRatios);
+BENCHMARK_TEMPLATE(BM_EraseDuringIteration, CountedList, int)->Apply(sizesAndRatios);
+BENCHMARK_TEMPLATE(BM_EraseDuringIteration, ChunkedList, int)->Apply(sizesAndRatios);
+BENCHMARK_TEMPLATE(BM_EraseDuringIteration, ChunkedList, std::string)->Apply(sizesAndRatios);
+BENCHMARK_TEMPLATE(BM_EraseDuringIteration, std::list, int)->Apply(sizesAndRatios);
+BENCHMARK_TEMPLATE(BM_EraseDuringIteration, std::list, std::string)->Apply(sizesAndRatios);
+BENCHMARK_TEMPLATE(BM_EraseDuringIteration, std::vector, int)->Apply(sizesAndRatios);
+BENCHMARK_TEMPLATE(BM_EraseDuringIteration, std::vector, std::string)->Apply(sizesAndRatios);
+BENCHMARK(BM_CChainEraseDuringIteration)->Apply(sizesAndRatios);
+BENCHMARK(BM_CChainForEachErase)->Apply(sizesAndRatios);
+
+BENCHMARK_TEMPLATE(BM_EraseIf, MutableList, int)->Apply(sizesAndRatios);
+BENCHMARK_TEMPLATE(BM_EraseIf, MutableList, std::string)->Apply(sizesAndRatios);
+BENCHMARK_TEMPLATE(BM_EraseIf, ChunkedList, int)->Apply(sizesAndRatios);
+BENCHMARK_TEMPLATE(BM_EraseIf, ChunkedList, std::string)->Apply(sizesAndRatios);
+BENCHMARK_TEMPLATE(BM_ChunkedThresholdErase, int, false)->Apply(sizesAndRatios);
+BENCHMARK_TEMPLATE(BM_ChunkedThresholdErase, int, true)->Apply(sizesAndRatios);
+BENCHMARK_TEMPLATE(BM_ChunkedThresholdErase, float, false)->Apply(sizesAndRatios);
+BENCHMARK_TEMPLATE(BM_ChunkedThresholdErase, float, true)->Apply(sizesAndRatios);
+BENCHMARK_TEMPLATE(BM_ChunkedCountBelow, int, false)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_ChunkedCountBelow, int, true)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_ChunkedCountBelow, float, false)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_ChunkedCountBelow, float, true)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_EraseIf, std::list, int)->Apply(sizesAndRatios);
+BENCHMARK_TEMPLATE(BM_EraseIf, std::list, std::string)->Apply(sizesAndRatios);
+
+BENCHMARK(BM_ConcurrentScan)->Arg(kMinSize)->Arg(kMaxSize)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK(BM_LockedScan)->Arg(kMinSize)->Arg(kMaxSize)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK(BM_MpscQueue)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_LockedQueue)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK(BM_SerialForEach)->Arg(1 << 20)->UseRealTime();
+BENCHMARK(BM_ParallelForEach)->ArgsProduct({{1 << 20}, {1, 2, 4, 8}})->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_EraseByValue, MutableList, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_EraseByValue, MutableList, std::string)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_EraseByValue, IndexedList, int)->Apply(sizes);
+BENCHMARK_TEMPLATE(BM_EraseByValue, IndexedList, std::string)->Apply(sizes);
+
+BENCHMARK(BM_NodeEraseInsert)->Apply(sizes);
+BENCHMARK(BM_HandleEraseInsert)->Apply(sizes);
+
+BENCHMARK(BM_SnapshotSave)->Apply(sizes);
+BENCHMARK(BM_SnapshotLoad)->Apply(sizes);
+BENCHMARK(BM_MappedScan)->Apply(sizes);
+
+BENCHMARK(BM_ReportCopy)->Apply(sizes);
+BENCHMARK(BM_ReportSnapshot)->Apply(sizes);
+BENCHMARK(BM_MaterializedPipeline)->ArgsProduct({{kMaxSize}, {100, kMaxSize}});
+BENCHMARK(BM_LazyPipeline)->ArgsProduct({{kMaxSize}, {100, kMaxSize}});
+BENCHMARK(BM_DuplicatedChains)->Apply(sizes);
+BENCHMARK(BM_MultiChain)->Apply(sizes);
+BENCHMARK(BM_LruEmulatedHit)->Apply(sizes);
+BENCHMARK(BM_LruCacheHit)->Apply(sizes);
+BENCHMARK(BM_ScatteredScan)->Arg(kMaxSize)->Arg(1 << 20);
+BENCHMARK(BM_ScatteredPrefetchScan)->Arg(kMaxSize)->Arg(1 << 20);
+BENCHMARK(BM_ScatteredWorkScan)->Arg(kMaxSize)->Arg(1 << 20);
+BENCHMARK(BM_ScatteredPrefetchWorkScan)->Arg(kMaxSize)->Arg(1 << 20);
+BENCHMARK(BM_CompactedScan)->Arg(kMaxSize)->Arg(1 << 20);
+BENCHMARK(BM_Compact)->Arg(kMaxSize)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,1126 @@
+/**
+ * @file mutable_chain_chunked.hpp
+ * @brief Unrolled MutableList variant: values stored in contiguous chunks
+ *
+ * ChunkedMutableList<T> keeps the Ref indirection of MutableList<T> but
+ * applies it per chunk instead of per element. Each ListChunk holds up to
+ * ChunkSize (at most 64) values in place plus an occupancy bitmap, and the
+ * chunks are linked through Ref slots exactly like ListNode<T>. A scan reads
+ * ChunkSize neighbouring values for every link it follows.
+ *
+ * @section chunkerase ERASE WHILE ITERATING
+ *
+ * Erasing a value destroys it and clears its occupancy bit (a tombstone);
+ * values never move between slots, so every other iterator, pointer and
+ * reference stays valid. An iterator standing on the erased slot steps to
+ * the next set bit, exactly as a MutableList iterator steps through the
+ * erased node's next slot.
+ *
+ * A chunk whose last value goes is unlinked by rewriting the Ref contents
+ * of its neighbours. Like an erased node it keeps its own slots, and it is
+ * retired rather than freed while iterators are pinned, so an iterator
+ * inside it still finds the rest of the list.
+ *
+ * @code
+ *     ChunkedMutableList<int> samples{3, 1, 4, 1, 5};
+ *     for (auto it = samples.begin(); it != samples.end(); ++it)
+ *         if (*it == 1)
+ *             samples.erase(it);  // Same contract as MutableList
+ * @endcode
+ *
+ * Values are only inserted at either end, so the slots of a chunk are
+ * handed out once from one side: push_back fills chunks upwards and
+ * push_front fills new chunks downwards. Interior holes left by erase are
+ * not refilled; an emptied chunk is released whole.
+ */
+
+#ifndef MUTABLE_CHAIN_CHUNKED_HPP
+#define MUTABLE_CHAIN_CHUNKED_HPP
+
+#include "mutable_chain.hpp"
+#include "mutable_chain_simd.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// ============================================================================
+// CHUNK TYPES
+// ============================================================================
+
+/**
+ * @brief Link slots and occupancy of one chunk (also the sentinel type).
+ *
+ * Sentinels are bare ListChunkLinks; the head sentinel is the only chunk
+ * with an empty prev slot and the tail the only one with an empty next slot.
+ */
+struct ListChunkLinks
+{
+    using RefType = Ref<ListChunkLinks>; ///< The Ref type for chunks
+
+    RefType next;               ///< Forward link slot (inline, mutated in place)
+    RefType prev;               ///< Backward link slot (inline, mutated in place)
+    std::uint64_t occupied = 0; ///< Bit i set: slot i holds a live value
+    unsigned lo = 0;            ///< First slot handed out
+    unsigned hi = 0;            ///< One past the last slot handed out
+};
+
+/**
+ * @brief A chunk of @p N in-place value slots.
+ *
+ * The slots are raw storage: values are constructed and destroyed one at a
+ * time, as recorded in @c occupied.
+ *
+ * @tparam T The value type
+ * @tparam N Slots per chunk (1 to 64)
+ */
+template <typename T, std::size_t N>
+struct ListChunk : ListChunkLinks
+{
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type slots[N]; ///< Value storage
+    static_assert(sizeof(slots[0]) == sizeof(T), "slots must be contiguous like T[N]");
+
+    /// User-provided so value-initialization leaves the slots untouched
+    ListChunk() {}
+
+    T *slot(unsigned i) { return reinterpret_cast<T *>(&slots[i]); }
+};
+
+/**
+ * @brief Unrolled doubly-linked list with per-chunk Ref indirection.
+ *
+ * Offers the MutableList<T> interface minus splice, with the same
+ * erase-while-iterating contract and the same pinned-iterator reclamation.
+ *
+ * Both sentinels are embedded in the list object and the pin state is only
+ * created with the first chunk, so an empty list allocates nothing and a
+ * move or swap relinks the boundary chunks without allocating.
+ *
+ * @tparam T The element type
+ * @tparam Allocator The allocator type (default: std::allocator<T>)
+ * @tparam ChunkSize Values per chunk, 1 to 64 (default: 64)
+ */
+template <typename T, typename Allocator = std::allocator<T>, std::size_t ChunkSize = 64>
+class ChunkedMutableList
+{
+    static_assert(ChunkSize >= 1 && ChunkSize <= 64,
+                  "ChunkSize must fit the 64-bit occupancy bitmap");
+
+public:
+    // ========================================================================
+    // STL TYPE ALIASES
+    // ========================================================================
+    using value_type = T;                       ///< Element type
+    using allocator_type = Allocator;           ///< Allocator type
+    using size_type = std::size_t;              ///< Unsigned integer type for sizes
+    using difference_type = std::ptrdiff_t;     ///< Signed integer type for differences
+    using reference = value_type &;             ///< Reference to element
+    using const_reference = const value_type &; ///< Const reference to element
+    using pointer = typename std::allocator_traits<Allocator>::pointer;
+    using const_pointer = typename std::allocator_traits<Allocator>::const_pointer;
+
+private:
+    using Links = ListChunkLinks;
+    using Chunk = ListChunk<T, ChunkSize>;
+    using ChunkAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Chunk>;
+    using ChunkTraits = std::allocator_traits<ChunkAllocator>;
+
+    /// Chunks [first, last] (following next) unlinked while iterators were pinned
+    struct Segment
+    {
+        Links *first;
+        Links *last;
+    };
+
+    // ------------------------------------------------------------------------
+    // Bitmap helpers
+    // ------------------------------------------------------------------------
+
+    static std::uint64_t bit(unsigned slot) { return std::uint64_t(1) << slot; }
+
+    /// Mask of the slots after @p slot
+    static std::uint64_t bitsAbove(unsigned slot)
+    {
+        return slot >= 63 ? 0 : ~std::uint64_t(0) << (slot + 1);
+    }
+
+    /// Mask of the slots before @p slot
+    static std::uint64_t bitsBelow(unsigned slot) { return bit(slot) - 1; }
+
+    /// Index of the lowest set bit (@p bits must be non-zero)
+    static unsigned lowestBit(std::uint64_t bits)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(bits));
+#endif
+    }
+
+    /// Index of the highest set bit (@p bits must be non-zero)
+    static unsigned highestBit(std::uint64_t bits)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse64(&index, bits);
+        return static_cast<unsigned>(index);
+#else
+        return 63u - static_cast<unsigned>(__builtin_clzll(bits));
+#endif
+    }
+
+    /// Number of set bits
+    static unsigned countBits(std::uint64_t bits)
+    {
+#if defined(_MSC_VER)
+        return static_cast<unsigned>(__popcnt64(bits));
+#else
+        return static_cast<unsigned>(__builtin_popcountll(bits));
+#endif
+    }
+
+    /// Live slots of @p chunk whose values satisfy @p pred (called once each, in order)
+    template <typename Pred>
+    static std::uint64_t matchMask(Chunk *chunk, Pred &pred)
+    {
+        std::uint64_t hits = 0;
+        for (std::uint64_t bits = chunk->occupied; bits; bits &= bits - 1)
+        {
+            unsigned slot = lowestBit(bits);
+            if (pred(static_cast<const T &>(*chunk->slot(slot))))
+                hits |= bit(slot);
+        }
+        return hits;
+    }
+
+    /// ValueIs on arithmetic values: one vector kernel over the handed-out range
+    template <ValueOp Op, typename U = T, std::enable_if_t<std::is_arithmetic<U>::value, int> = 0>
+    static std::uint64_t matchMask(Chunk *chunk, ValueIs<T, Op> &pred)
+    {
+        // Tombstones in [lo, hi) still hold plain bytes; the bitmap masks them out
+        const unsigned lo = chunk->lo;
+        std::uint64_t hits = ValueKernel<T, Op>::mask(chunk->slot(lo), chunk->hi - lo, pred.operand);
+        return (hits << lo) & chunk->occupied;
+    }
+
+    /// "== value" predicate: the vectorized ValueIs for arithmetic T
+    template <typename U = T, std::enable_if_t<std::is_arithmetic<U>::value, int> = 0>
+    static ValueIs<T, ValueOp::Equal> equalTo(const T &value)
+    {
+        return equals(value);
+    }
+
+    /// "== value" predicate for other T (no copy of @p value)
+    template <typename U = T, std::enable_if_t<!std::is_arithmetic<U>::value, int> = 0>
+    static auto equalTo(const T &value)
+    {
+        return [&value](const T &v) { return v == value; };
+    }
+
+    /// Release unlinked chunks [first, last]; their values are already gone
+    static void freeChain(ChunkAllocator &alloc, Links *first, Links *last)
+    {
+        for (Links *links = first;;)
+        {
+            Links *next = links->next.ptr;
+            Chunk *chunk = static_cast<Chunk *>(links);
+            ChunkTraits::destroy(alloc, chunk);
+            ChunkTraits::deallocate(alloc, chunk, 1);
+            if (links == last)
+                break;
+            links = next;
+        }
+    }
+
+    /**
+     * @brief Pin count and retired chunks shared by a list and its iterators.
+     *
+     * Same scheme as MutableList::PinState: heap-allocated so it can outlive
+     * the list while iterators still hold pins, and only mutators touch
+     * @c retired.
+     */
+    struct PinState
+    {
+        using StateAllocator = typename ChunkTraits::template rebind_alloc<PinState>;
+        using StateTraits = std::allocator_traits<StateAllocator>;
+        using SegmentAllocator = typename ChunkTraits::template rebind_alloc<Segment>;
+
+        ChunkAllocator alloc;                           ///< Frees retired chunks
+        std::atomic<size_type> pins{0};                 ///< Live pinned iterators
+        std::vector<Segment, SegmentAllocator> retired; ///< Unlinked while pinned
+        std::atomic<bool> reclaiming{false};            ///< Held by the unpin releasing @c retired
+        bool detached = false;                          ///< Owning list has been destroyed
+
+        explicit PinState(const ChunkAllocator &a) : alloc(a), retired(SegmentAllocator(a)) {}
+
+        static PinState *create(const ChunkAllocator &a)
+        {
+            StateAllocator sa(a);
+            PinState *state = StateTraits::allocate(sa, 1);
+            try
+            {
+                StateTraits::construct(sa, state, a);
+            }
+            catch (...)
+            {
+                StateTraits::deallocate(sa, state, 1);
+                throw;
+            }
+            return state;
+        }
+
+        static void destroy(PinState *state)
+        {
+            state->reclaim();
+            StateAllocator sa(state->alloc);
+            StateTraits::destroy(sa, state);
+            StateTraits::deallocate(sa, state, 1);
+        }
+
+        bool pinned() const { return pins.load(std::memory_order_acquire) != 0; }
+
+        void pin() { pins.fetch_add(1, std::memory_order_relaxed); }
+
+        /// Drop a pin; the last one releases retired chunks (or the state itself).
+        /// Readers on several threads can each reach zero, so the release is claimed.
+        static void unpin(PinState *state)
+        {
+            if (state->pins.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+            if (state->detached)
+            {
+                destroy(state);
+                return;
+            }
+            if (state->reclaiming.exchange(true, std::memory_order_acquire))
+                return; // Another thread's last unpin is releasing them
+            state->reclaim();
+            state->reclaiming.store(false, std::memory_order_release);
+        }
+
+        /// Called by the owning list's destructor
+        static void detach(PinState *state)
+        {
+            state->reclaim();
+            state->detached = true;
+            if (!state->pinned())
+                destroy(state);
+        }
+
+        /// Release every retired segment
+        void reclaim()
+        {
+            for (const Segment &seg : retired)
+                freeChain(alloc, seg.first, seg.last);
+            retired.clear();
+        }
+    };
+
+    ChunkAllocator alloc_;     ///< Source of every chunk
+    Links head_sentinel_;      ///< Before the first chunk (prev slot stays empty)
+    Links tail_sentinel_;      ///< After the last chunk (next slot stays empty)
+    size_type size_ = 0;       ///< Number of elements
+    PinState *pins_ = nullptr; ///< Pins held by iterators (created with the first chunk)
+    Chunk *spare_ = nullptr;   ///< One emptied chunk kept for reuse
+
+    /// The sentinel before the first chunk
+    Links *head() const { return const_cast<Links *>(&head_sentinel_); }
+
+    /// The sentinel after the last chunk
+    Links *tail() const { return const_cast<Links *>(&tail_sentinel_); }
+
+    /// Create the pin state; called before the first chunk enters the list
+    void ensurePins()
+    {
+        if (!pins_)
+            pins_ = PinState::create(alloc_);
+    }
+
+    /**
+     * @brief Point the boundary links at our sentinels after they took over another list's links.
+     *
+     * Used by move and swap: the first and last chunk, and any retired chunk
+     * whose slots still lead to @p from_head or @p from_tail, are rewritten
+     * to lead here.
+     */
+    void rehome(Links *from_head, Links *from_tail) noexcept
+    {
+        if (head()->next.ptr == from_tail) // Took over an empty list
+        {
+            link(head(), tail());
+        }
+        else
+        {
+            head()->next.ptr->prev.ptr = head();
+            tail()->prev.ptr->next.ptr = tail();
+        }
+        if (!pins_)
+            return;
+        for (const Segment &seg : pins_->retired)
+        {
+            if (seg.first->prev.ptr == from_head)
+                seg.first->prev.ptr = head();
+            if (seg.last->next.ptr == from_tail)
+                seg.last->next.ptr = tail();
+        }
+    }
+
+    /// Create bidirectional link between two chunks using Ref slots
+    static void link(Links *a, Links *b)
+    {
+        a->next.ptr = b;
+        b->prev.ptr = a;
+    }
+
+    /// Step to the next live slot (or the tail sentinel)
+    static void stepForward(Links *&chunk, unsigned &slot)
+    {
+        std::uint64_t rest = chunk->occupied & bitsAbove(slot);
+        while (!rest)
+        {
+            chunk = chunk->next.ptr;
+            if (!chunk->next.ptr)
+            {
+                slot = 0;
+                return;
+            }
+            rest = chunk->occupied;
+        }
+        slot = lowestBit(rest);
+    }
+
+    /// Step to the previous live slot (or the head sentinel)
+    static void stepBackward(Links *&chunk, unsigned &slot)
+    {
+        std::uint64_t rest = chunk->occupied & bitsBelow(slot);
+        while (!rest)
+        {
+            chunk = chunk->prev.ptr;
+            if (!chunk->prev.ptr)
+            {
+                slot = 0;
+                return;
+            }
+            rest = chunk->occupied;
+        }
+        slot = highestBit(rest);
+    }
+
+    /// Get an empty chunk whose slots will be handed out from @p start
+    Chunk *makeChunk(unsigned start)
+    {
+        Chunk *chunk = spare_;
+        if (chunk)
+        {
+            spare_ = nullptr;
+        }
+        else
+        {
+            ensurePins();
+            chunk = ChunkTraits::allocate(alloc_, 1);
+            ChunkTraits::construct(alloc_, chunk);
+        }
+        chunk->lo = start;
+        chunk->hi = start;
+        return chunk;
+    }
+
+    /// Release an empty chunk that was never linked, or keep it as the spare
+    void dropChunk(Chunk *chunk)
+    {
+        if (!spare_)
+        {
+            spare_ = chunk;
+            return;
+        }
+        ChunkTraits::destroy(alloc_, chunk);
+        ChunkTraits::deallocate(alloc_, chunk, 1);
+    }
+
+    /// Construct a value in @p slot of @p chunk and mark it live
+    template <typename... Args>
+    reference place(Chunk *chunk, unsigned slot, Args &&...args)
+    {
+        T *value = chunk->slot(slot);
+        ChunkTraits::construct(alloc_, value, std::forward<Args>(args)...);
+        chunk->occupied |= bit(slot);
+        ++size_;
+        return *value;
+    }
+
+    /// Destroy the live values selected by @p mask in @p chunk
+    size_type destroyValues(Chunk *chunk, std::uint64_t mask)
+    {
+        size_type count = 0;
+        for (std::uint64_t bits = mask; bits; bits &= bits - 1)
+        {
+            ChunkTraits::destroy(alloc_, chunk->slot(lowestBit(bits)));
+            ++count;
+        }
+        chunk->occupied &= ~mask;
+        size_ -= count;
+        return count;
+    }
+
+    /**
+     * @brief Dispose of unlinked, empty chunks [first, last].
+     *
+     * Kept on the retired list while iterators are pinned; otherwise freed
+     * at once (the first one becomes the spare if there is none).
+     * Call reserveRetired() before unlinking so this cannot throw.
+     */
+    void retire(Links *first, Links *last)
+    {
+        if (pins_->pinned())
+        {
+            pins_->retired.push_back(Segment{first, last});
+            return;
+        }
+        if (!spare_)
+        {
+            spare_ = static_cast<Chunk *>(first);
+            if (first == last)
+                return;
+            first = first->next.ptr;
+        }
+        freeChain(alloc_, first, last);
+        pins_->reclaim();
+    }
+
+    /// Make room for one retired segment (the only allocation on erase paths)
+    void reserveRetired()
+    {
+        if (pins_->pinned() && pins_->retired.size() == pins_->retired.capacity())
+            pins_->retired.reserve(pins_->retired.size() * 2 + 1);
+    }
+
+    /**
+     * @brief Settle @p chunk after values were removed from it.
+     *
+     * An emptied chunk is unlinked through its neighbours' Ref slots and
+     * retired; otherwise its handed-out range shrinks to the live slots so
+     * the ends can be reused by pushes.
+     */
+    void settle(Chunk *chunk)
+    {
+        if (chunk->occupied == 0)
+        {
+            link(chunk->prev.ptr, chunk->next.ptr);
+            retire(chunk, chunk);
+            return;
+        }
+        chunk->lo = lowestBit(chunk->occupied);
+        chunk->hi = highestBit(chunk->occupied) + 1;
+    }
+
+    /// Erase the value in @p slot of @p chunk (retiring the chunk if it empties)
+    void eraseSlot(Chunk *chunk, unsigned slot)
+    {
+        reserveRetired();
+        destroyValues(chunk, bit(slot));
+        settle(chunk);
+    }
+
+public:
+    // ========================================================================
+    // ITERATOR
+    // ========================================================================
+
+    /**
+     * @brief Bidirectional iterator over (chunk, slot) positions.
+     *
+     * Stepping scans the occupancy bitmap of the current chunk and follows
+     * the chunk's Ref slot only when the chunk is exhausted. Pins work as in
+     * MutableList: taken on creation or copy, dropped on destruction, and
+     * taken lazily by end()/rend(). An iterator taken before the list ever
+     * held a chunk has no pin state to join, as in MutableList.
+     *
+     * @tparam IsConst If true, produces const references
+     * @tparam Reverse If true, ++ moves towards the front (reverse_iterator)
+     */
+    template <bool IsConst, bool Reverse = false>
+    class IteratorImpl
+    {
+        friend class ChunkedMutableList;
+        template <bool, bool>
+        friend class IteratorImpl;
+
+        Links *chunk_ = nullptr;
+        unsigned slot_ = 0;
+        PinState *pins_ = nullptr;
+        bool pinned_ = false;
+
+        IteratorImpl(Links *chunk, unsigned slot, PinState *pins, bool pin)
+            : chunk_(chunk), slot_(slot), pins_(pins)
+        {
+            if (pin && pins)
+                acquire();
+        }
+
+        void acquire()
+        {
+            pins_->pin();
+            pinned_ = true;
+        }
+
+        void release()
+        {
+            if (pinned_)
+                PinState::unpin(pins_);
+            pinned_ = false;
+        }
+
+        void forward()
+        {
+            if (!pinned_ && pins_)
+                acquire();
+            stepForward(chunk_, slot_);
+        }
+
+        void backward()
+        {
+            if (!pinned_ && pins_)
+                acquire();
+            stepBackward(chunk_, slot_);
+        }
+
+    public:
+        // STL iterator traits
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = std::conditional_t<IsConst, const T, T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = value_type *;
+        using reference = value_type &;
+
+        IteratorImpl() = default;
+
+        IteratorImpl(const IteratorImpl &other)
+            : chunk_(other.chunk_), slot_(other.slot_), pins_(other.pins_)
+        {
+            if (other.pinned_)
+                acquire();
+        }
+
+        IteratorImpl(IteratorImpl &&other) noexcept
+            : chunk_(other.chunk_), slot_(other.slot_), pins_(other.pins_), pinned_(other.pinned_)
+        {
+            other.pinned_ = false;
+        }
+
+        /// Allow conversion from non-const to const iterator
+        template <bool WasConst, typename = std::enable_if_t<IsConst && !WasConst>>
+        IteratorImpl(const IteratorImpl<WasConst, Reverse> &other)
+            : chunk_(other.chunk_), slot_(other.slot_), pins_(other.pins_)
+        {
+            if (other.pinned_)
+                acquire();
+        }
+
+        /// Copy/move assignment (copy-and-swap keeps the pin balanced)
+        IteratorImpl &operator=(IteratorImpl other) noexcept
+        {
+            std::swap(chunk_, other.chunk_);
+            std::swap(slot_, other.slot_);
+            std::swap(pins_, other.pins_);
+            std::swap(pinned_, other.pinned_);
+            return *this;
+        }
+
+        ~IteratorImpl() { release(); }
+
+        reference operator*() const { return *static_cast<Chunk *>(chunk_)->slot(slot_); }
+        pointer operator->() const { return static_cast<Chunk *>(chunk_)->slot(slot_); }
+
+        IteratorImpl &operator++()
+        {
+            if (Reverse)
+                backward();
+            else
+                forward();
+            return *this;
+        }
+
+        IteratorImpl operator++(int)
+        {
+            IteratorImpl tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        IteratorImpl &operator--()
+        {
+            if (Reverse)
+                forward();
+            else
+                backward();
+            return *this;
+        }
+
+        IteratorImpl operator--(int)
+        {
+            IteratorImpl tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        template <bool C>
+        bool operator==(const IteratorImpl<C, Reverse> &o) const
+        {
+            return chunk_ == o.chunk_ && slot_ == o.slot_;
+        }
+        template <bool C>
+        bool operator!=(const IteratorImpl<C, Reverse> &o) const
+        {
+            return !(*this == o);
+        }
+
+        /// Forward iterator to the element after this one in reverse order
+        /// (same contract as std::reverse_iterator::base)
+        template <bool R = Reverse, typename = std::enable_if_t<R>>
+        IteratorImpl<IsConst, false> base() const
+        {
+            IteratorImpl<IsConst, false> it(chunk_, slot_, pins_, true);
+            ++it;
+            return it;
+        }
+    };
+
+    using iterator = IteratorImpl<false>;
+    using const_iterator = IteratorImpl<true>;
+    using reverse_iterator = IteratorImpl<false, true>;
+    using const_reverse_iterator = IteratorImpl<true, true>;
+
+    // ========================================================================
+    // CONSTRUCTION / DESTRUCTION
+    // ========================================================================
+
+    /// Default constructor: creates an empty list (no allocation)
+    ChunkedMutableList() : ChunkedMutableList(Allocator()) {}
+
+    /// Allocator constructor: creates an empty list allocating from @p alloc (no allocation)
+    explicit ChunkedMutableList(const Allocator &alloc) noexcept : alloc_(alloc)
+    {
+        link(head(), tail());
+    }
+
+    /// Initializer list constructor
+    ChunkedMutableList(std::initializer_list<T> init, const Allocator &alloc = Allocator())
+        : ChunkedMutableList(alloc)
+    {
+        for (const auto &v : init)
+            push_back(v);
+    }
+
+    /// Copy constructor (the copy is packed: no tombstones)
+    ChunkedMutableList(const ChunkedMutableList &other)
+        : ChunkedMutableList(std::allocator_traits<Allocator>::select_on_container_copy_construction(
+              Allocator(other.alloc_)))
+    {
+        for (const auto &v : other)
+            push_back(v);
+    }
+
+    /**
+     * @brief Move constructor: relinks the two boundary chunks, allocates nothing.
+     *
+     * The moved-from list is left empty, with a copy of the allocator and no
+     * pin state. Iterators to elements move along with them; end() does not.
+     */
+    ChunkedMutableList(ChunkedMutableList &&other) noexcept
+        : alloc_(other.alloc_), size_(other.size_), pins_(other.pins_), spare_(other.spare_)
+    {
+        head()->next.ptr = other.head()->next.ptr;
+        tail()->prev.ptr = other.tail()->prev.ptr;
+        rehome(other.head(), other.tail());
+        link(other.head(), other.tail());
+        other.size_ = 0;
+        other.pins_ = nullptr;
+        other.spare_ = nullptr;
+    }
+
+    /// Destructor: destroys every value and frees every chunk, including retired ones
+    ~ChunkedMutableList()
+    {
+        for (Links *links = head()->next.ptr; links != tail();)
+        {
+            Links *next = links->next.ptr;
+            Chunk *chunk = static_cast<Chunk *>(links);
+            destroyValues(chunk, chunk->occupied);
+            ChunkTraits::destroy(alloc_, chunk);
+            ChunkTraits::deallocate(alloc_, chunk, 1);
+            links = next;
+        }
+        if (spare_)
+            freeChain(alloc_, spare_, spare_);
+        if (pins_)
+            PinState::detach(pins_);
+    }
+
+    /// Copy/move assignment (copy-and-swap idiom)
+    ChunkedMutableList &operator=(ChunkedMutableList other)
+    {
+        swap(other);
+        return *this;
+    }
+
+    /// Swap contents with another list (O(1): the boundary chunks are relinked)
+    void swap(ChunkedMutableList &other) noexcept
+    {
+        using std::swap;
+        swap(alloc_, other.alloc_);
+        std::swap(head()->next.ptr, other.head()->next.ptr);
+        std::swap(tail()->prev.ptr, other.tail()->prev.ptr);
+        std::swap(size_, other.size_);
+        std::swap(pins_, other.pins_);
+        std::swap(spare_, other.spare_);
+        rehome(other.head(), other.tail());
+        other.rehome(head(), tail());
+    }
+
+    /// Get a copy of the allocator
+    allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+    // ========================================================================
+    // ITERATORS
+    // ========================================================================
+
+    iterator begin() { return ++iterator(head(), 0, pins_, true); }
+    iterator end() { return iterator(tail(), 0, pins_, false); }
+    const_iterator begin() const { return ++const_iterator(head(), 0, pins_, true); }
+    const_iterator end() const { return const_iterator(tail(), 0, pins_, false); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    reverse_iterator rbegin() { return ++reverse_iterator(tail(), 0, pins_, true); }
+    reverse_iterator rend() { return reverse_iterator(head(), 0, pins_, false); }
+    const_reverse_iterator rbegin() const { return ++const_reverse_iterator(tail(), 0, pins_, true); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(head(), 0, pins_, false); }
+    const_reverse_iterator crbegin() const { return rbegin(); }
+    const_reverse_iterator crend() const { return rend(); }
+
+    /**
+     * @brief Visit every element in order, a chunk at a time.
+     *
+     * Each run of consecutive live slots is visited with a plain pointer
+     * loop, without the per-step pin bookkeeping of an iterator. The list
+     * stays pinned for the whole call, and the loop compares the chunk's
+     * bitmap with the one it started from after every call to @p f, so @p f
+     * may insert or erase (including the element it is visiting) under the
+     * same contract as iteration: erased elements are not visited, and an
+     * emptied chunk is retired rather than freed until the walk has left it.
+     */
+    template <typename F>
+    void for_each(F f)
+    {
+        if (empty())
+            return;
+        iterator guard = begin(); // Pins the list while f runs
+        for (Links *links = head()->next.ptr; links != tail(); links = links->next.ptr)
+        {
+            Chunk *chunk = static_cast<Chunk *>(links);
+            for (std::uint64_t bits = chunk->occupied; bits;)
+            {
+                const std::uint64_t seen = chunk->occupied; // Bitmap this run started from
+                const unsigned first = lowestBit(bits);
+                const std::uint64_t gaps = ~seen & bitsAbove(first);
+                const unsigned end = gaps ? lowestBit(gaps) : 64;
+                unsigned slot = first;
+                for (T *value = chunk->slot(first); slot != end; ++value)
+                {
+                    f(*value);
+                    ++slot;
+                    if (chunk->occupied != seen)
+                        break; // f changed this chunk: resume from the bitmap
+                }
+                bits = slot >= 64 ? 0 : chunk->occupied & ~bitsBelow(slot);
+            }
+        }
+    }
+
+    template <typename F>
+    void for_each(F f) const
+    {
+        const_cast<ChunkedMutableList *>(this)->for_each(
+            [&f](const T &value) { f(value); });
+    }
+
+    // ========================================================================
+    // CAPACITY
+    // ========================================================================
+
+    /// Check if the list is empty
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+
+    /// Get the number of elements
+    [[nodiscard]] size_type size() const { return size_; }
+
+    // ========================================================================
+    // ELEMENT ACCESS
+    // ========================================================================
+
+    /// Access the first element
+    reference front()
+    {
+        Chunk *chunk = static_cast<Chunk *>(head()->next.ptr);
+        return *chunk->slot(lowestBit(chunk->occupied));
+    }
+    const_reference front() const { return const_cast<ChunkedMutableList *>(this)->front(); }
+
+    /// Access the last element
+    reference back()
+    {
+        Chunk *chunk = static_cast<Chunk *>(tail()->prev.ptr);
+        return *chunk->slot(highestBit(chunk->occupied));
+    }
+    const_reference back() const { return const_cast<ChunkedMutableList *>(this)->back(); }
+
+    // ========================================================================
+    // MODIFIERS
+    // ========================================================================
+
+    /// Remove all elements (chunks released now, or once outstanding iterators are gone)
+    void clear()
+    {
+        if (head()->next.ptr == tail())
+            return;
+        reserveRetired();
+        Links *first = head()->next.ptr;
+        Links *last = tail()->prev.ptr;
+        for (Links *links = first; links != tail(); links = links->next.ptr)
+        {
+            Chunk *chunk = static_cast<Chunk *>(links);
+            destroyValues(chunk, chunk->occupied);
+        }
+        link(head(), tail());
+        retire(first, last);
+    }
+
+    /**
+     * @brief Construct element in-place at the end.
+     *
+     * Fills the last chunk upwards; starts a new chunk when its top slot is
+     * taken.
+     *
+     * @param args Arguments forwarded to T's constructor
+     * @return Reference to the inserted element
+     */
+    template <typename... Args>
+    reference emplace_back(Args &&...args)
+    {
+        Links *last = tail()->prev.ptr;
+        if (last != head() && last->hi < ChunkSize)
+        {
+            reference value = place(static_cast<Chunk *>(last), last->hi, std::forward<Args>(args)...);
+            ++last->hi;
+            return value;
+        }
+        Chunk *chunk = makeChunk(0);
+        try
+        {
+            place(chunk, 0, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            dropChunk(chunk);
+            throw;
+        }
+        chunk->hi = 1;
+        link(last, chunk);
+        link(chunk, tail());
+        return *chunk->slot(0);
+    }
+
+    /// Add element to the end (copy)
+    void push_back(const T &value) { emplace_back(value); }
+
+    /// Add element to the end (move)
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    /**
+     * @brief Construct element in-place at the beginning.
+     *
+     * Fills the first chunk downwards; starts a new chunk (filled from its
+     * top slot) when its bottom slot is taken.
+     *
+     * @param args Arguments forwarded to T's constructor
+     * @return Reference to the inserted element
+     */
+    template <typename... Args>
+    reference emplace_front(Args &&...args)
+    {
+        Links *first = head()->next.ptr;
+        if (first != tail() && first->lo > 0)
+        {
+            reference value =
+                place(static_cast<Chunk *>(first), first->lo - 1, std::forward<Args>(args)...);
+            --first->lo;
+            return value;
+        }
+        const unsigned top = static_cast<unsigned>(ChunkSize - 1);
+        Chunk *chunk = makeChunk(top);
+        try
+        {
+            place(chunk, top, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            dropChunk(chunk);
+            throw;
+        }
+        chunk->hi = top + 1;
+        link(head(), chunk);
+        link(chunk, first);
+        return *chunk->slot(top);
+    }
+
+    /// Add element to the beginning (copy)
+    void push_front(const T &value) { emplace_front(value); }
+
+    /// Add element to the beginning (move)
+    void push_front(T &&value) { emplace_front(std::move(value)); }
+
+    /// Remove the last element
+    void pop_back()
+    {
+        if (!empty())
+        {
+            Chunk *chunk = static_cast<Chunk *>(tail()->prev.ptr);
+            eraseSlot(chunk, highestBit(chunk->occupied));
+        }
+    }
+
+    /// Remove the first element
+    void pop_front()
+    {
+        if (!empty())
+        {
+            Chunk *chunk = static_cast<Chunk *>(head()->next.ptr);
+            eraseSlot(chunk, lowestBit(chunk->occupied));
+        }
+    }
+
+    /**
+     * @brief Erase element at iterator position.
+     *
+     * **SAFE DURING ITERATION**: the slot becomes a tombstone, so @p pos and
+     * every other iterator keep stepping correctly from it.
+     *
+     * @param pos Iterator to the element to remove
+     * @return Iterator to the element following the removed element
+     */
+    iterator erase(iterator pos)
+    {
+        eraseSlot(static_cast<Chunk *>(pos.chunk_), pos.slot_);
+        return ++pos;
+    }
+
+    /**
+     * @brief Erase every element matching @p pred in one pass.
+     *
+     * Each chunk is tested as a whole: matches are collected into a mask,
+     * cleared from the bitmap together, and an emptied chunk is unlinked
+     * with one Ref rewrite on each side. @p pred is called exactly once per
+     * element, in order, except that equals(), less_than() and
+     * greater_than() on arithmetic T run as one vector kernel per chunk
+     * (see mutable_chain_simd.hpp).
+     *
+     * @param pred Unary predicate on const T&
+     * @return Number of elements removed
+     */
+    template <typename Pred>
+    size_type erase_if(Pred pred)
+    {
+        size_type removed = 0;
+        for (Links *links = head()->next.ptr; links != tail();)
+        {
+            Links *next = links->next.ptr;
+            Chunk *chunk = static_cast<Chunk *>(links);
+            std::uint64_t doomed = matchMask(chunk, pred);
+            if (doomed)
+            {
+                reserveRetired();
+                removed += destroyValues(chunk, doomed);
+                settle(chunk);
+            }
+            links = next;
+        }
+        return removed;
+    }
+
+    /// Number of elements matching @p pred (vectorized like erase_if())
+    template <typename Pred>
+    size_type count_if(Pred pred) const
+    {
+        size_type count = 0;
+        for (Links *links = head()->next.ptr; links != tail(); links = links->next.ptr)
+            count += countBits(matchMask(static_cast<Chunk *>(links), pred));
+        return count;
+    }
+
+    /// Number of elements equal to @p value
+    size_type count(const T &value) const { return count_if(equalTo(value)); }
+
+    /// First element matching @p pred, or end() (vectorized like erase_if())
+    template <typename Pred>
+    iterator find_if(Pred pred)
+    {
+        for (Links *links = head()->next.ptr; links != tail(); links = links->next.ptr)
+        {
+            std::uint64_t hits = matchMask(static_cast<Chunk *>(links), pred);
+            if (hits)
+                return iterator(links, lowestBit(hits), pins_, true);
+        }
+        return end();
+    }
+
+    template <typename Pred>
+    const_iterator find_if(Pred pred) const
+    {
+        return const_cast<ChunkedMutableList *>(this)->find_if(std::move(pred));
+    }
+
+    /// First element equal to @p value, or end()
+    iterator find(const T &value) { return find_if(equalTo(value)); }
+    const_iterator find(const T &value) const { return find_if(equalTo(value)); }
+
+    /// std::list spelling of erase_if()
+    template <typename Pred>
+    size_type remove_if(Pred pred)
+    {
+        return erase_if(std::move(pred));
+    }
+
+    /// Erase every element equal to @p value
+    size_type remove(const T &value)
+    {
+        return erase_if(equalTo(value));
+    }
+};
+
+/// Free function swap for ADL (Argument-Dependent Lookup)
+template <typename T, typename A, std::size_t N>
+void swap(ChunkedMutableList<T, A, N> &a, ChunkedMutableList<T, A, N> &b) noexcept
+{
+    a.swap(b);
+}
+
+/// Free function erase_if, mirroring std::erase_if for std::list
+template <typename T, typename A, std::size_t N, typename Pred>
+typename ChunkedMutableList<T, A, N>::size_type erase_if(ChunkedMutableList<T, A, N> &list, Pred pred)
+{
+    return list.erase_if(std::move(pred));
+}
+
+#endif // MUTABLE_CHAIN_CHUNKED_HPP
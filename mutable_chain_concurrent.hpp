@@ -0,0 +1,694 @@
+/**
+ * @file mutable_chain_concurrent.hpp
+ * @brief Thread-safe MutableList variant with lock-free readers
+ *
+ * ConcurrentMutableList<T> keeps the Ref indirection of MutableList<T> but
+ * makes every link slot atomic (AtomicRef<T>), so the "update Ref contents,
+ * not pointers" erase becomes two release stores that readers can follow
+ * without taking any lock.
+ *
+ * @section concurrency CONCURRENCY MODEL
+ *
+ * - **Readers** (iterators, for_each) never lock. They load next/prev with
+ *   acquire ordering and register in a read epoch for the duration of the
+ *   traversal.
+ * - **Writers** (insert/erase) lock only the nodes whose Ref slots they
+ *   rewrite: the predecessor, the node and the successor, always in list
+ *   order, so writers working on different parts of the chain proceed in
+ *   parallel. Each node carries a one-byte spin lock.
+ * - An erased node's own slots are never rewritten, so a reader standing
+ *   on it still steps to a node that was live when it was erased, exactly
+ *   like the single-threaded list.
+ *
+ * @section reclamation RECLAMATION
+ *
+ * Erased nodes are handed to a two-epoch scheme: readers count themselves
+ * into the slot of the current epoch, writers push erased nodes onto the
+ * retire stack of the current epoch, and the epoch only advances once every
+ * reader of the previous one has left. The stack from two epochs back is
+ * freed at that point, since no reader that could still see those nodes
+ * remains. A long-lived iterator therefore holds reclamation back, but
+ * never blocks writers.
+ *
+ * The retire stacks are intrusive (linked through a slot of the dead node
+ * that readers never follow) and pushed with a CAS, so an erase takes no
+ * lock and allocates nothing after the unlink. Advancing the epoch is not
+ * part of an erase: every kAdvanceInterval-th erasure on the list attempts
+ * it, and try_reclaim() attempts it on demand. An attempt
+ * that finds another thread advancing returns at once.
+ *
+ * @code
+ *     ConcurrentMutableList<Event> events;
+ *     // producer thread
+ *     events.push_back(make_event());
+ *     // any number of consumer threads
+ *     for (auto it = events.begin(); it != events.end(); ++it)
+ *         if (done(*it))
+ *             events.erase(it);  // Safe; other threads keep iterating
+ * @endcode
+ */
+
+#ifndef MUTABLE_CHAIN_CONCURRENT_HPP
+#define MUTABLE_CHAIN_CONCURRENT_HPP
+
+#include "mutable_chain.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <utility>
+
+// ============================================================================
+// GENERIC COMPONENTS
+// ============================================================================
+
+/**
+ * @brief Ref<T> with an atomic pointer: the indirection slot shared by threads.
+ *
+ * Writers store into ptr with release ordering after the target is fully
+ * linked; readers load with acquire ordering, so a reader that follows a
+ * slot always sees a consistent node.
+ *
+ * @tparam T The type being referenced (typically a node type)
+ */
+template <typename T>
+struct AtomicRef
+{
+    std::atomic<T *> ptr{nullptr}; ///< The actual pointer, mutated in place
+
+    T *load() const { return ptr.load(std::memory_order_acquire); }
+    void store(T *p) { ptr.store(p, std::memory_order_release); }
+};
+
+/**
+ * @brief Node of ConcurrentMutableList: atomic link slots plus a node lock.
+ *
+ * @c erased is only read or written while the node is locked. Only element
+ * nodes hold a constructed value (see ListNodeValue); the list destroys it
+ * before releasing the node.
+ *
+ * @tparam T The value type stored in this node
+ */
+template <typename T>
+struct ConcurrentListNode : ListNodeValue<T>
+{
+    using RefType = AtomicRef<ConcurrentListNode<T>>; ///< The Ref type for this node
+
+    /// Tag selecting the element constructor
+    struct Emplace
+    {
+    };
+
+    RefType next;                          ///< Forward link slot
+    RefType prev;                          ///< Backward link slot
+    ConcurrentListNode *limbo = nullptr;   ///< Next node on a retire stack (never read by readers)
+    std::atomic<bool> locked{false};       ///< Spin lock guarding this node's slots
+    bool erased = false;                   ///< Unlinked (guarded by the node lock)
+
+    /// Sentinel constructor: links only, no value is constructed
+    ConcurrentListNode() {}
+
+    /// Element constructor: the value is built from @p args with perfect forwarding
+    template <typename... Args>
+    explicit ConcurrentListNode(Emplace, Args &&...args)
+    {
+        ::new (static_cast<void *>(std::addressof(this->value))) T(std::forward<Args>(args)...);
+    }
+
+    void lock()
+    {
+        while (locked.exchange(true, std::memory_order_acquire))
+        {
+            while (locked.load(std::memory_order_relaxed))
+                std::this_thread::yield();
+        }
+    }
+
+    void unlock() { locked.store(false, std::memory_order_release); }
+};
+
+/**
+ * @brief Doubly-linked list safe for concurrent readers and writers.
+ *
+ * Element access is const-only: values are shared by every thread that can
+ * reach the node, so they are set at insertion and read afterwards. Size is
+ * maintained atomically and is exact only when no writer is running.
+ *
+ * The allocator must be safe to use from every writer thread
+ * (std::allocator is; PoolAllocator is not).
+ *
+ * @tparam T The element type
+ * @tparam Allocator The allocator type (default: std::allocator<T>)
+ */
+template <typename T, typename Allocator = std::allocator<T>>
+class ConcurrentMutableList
+{
+public:
+    // ========================================================================
+    // STL TYPE ALIASES
+    // ========================================================================
+    using value_type = T;                       ///< Element type
+    using allocator_type = Allocator;           ///< Allocator type
+    using size_type = std::size_t;              ///< Unsigned integer type for sizes
+    using difference_type = std::ptrdiff_t;     ///< Signed integer type for differences
+    using const_reference = const value_type &; ///< Const reference to element
+
+private:
+    using Node = ConcurrentListNode<T>;
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    /// Erasures on a list between two attempts to advance the epoch
+    static constexpr unsigned kAdvanceInterval = 64;
+
+    /// Reader count for one epoch parity, padded to a cache line (padding
+    /// rather than alignas, which C++14 operator new does not honour)
+    struct ReaderSlot
+    {
+        std::atomic<size_type> count{0};
+        char pad[64 - sizeof(std::atomic<size_type>)];
+    };
+
+    NodeAllocator alloc_;             ///< Source of every node
+    Node *head_;                      ///< Sentinel node before first element
+    Node *tail_;                      ///< Sentinel node after last element
+    std::atomic<size_type> size_{0};  ///< Number of linked elements
+
+    std::atomic<std::size_t> epoch_{0};    ///< Current read epoch
+    mutable ReaderSlot readers_[2];        ///< Readers registered per epoch parity
+    std::atomic<Node *> limbo_[2] = {};    ///< Retire stack per epoch parity
+    std::atomic<bool> advancing_{false};   ///< Held by the one thread advancing the epoch
+    std::atomic<unsigned> retired_{0};     ///< Retirements so far, to pace tryAdvance()
+
+    /// Allocate an element node, constructing its value from @p args
+    template <typename... Args>
+    Node *makeNode(Args &&...args)
+    {
+        return allocateNode(typename Node::Emplace(), std::forward<Args>(args)...);
+    }
+
+    /// Allocate a sentinel (links only, no value)
+    Node *makeSentinel() { return allocateNode(); }
+
+    template <typename... Args>
+    Node *allocateNode(Args &&...args)
+    {
+        Node *node = NodeTraits::allocate(alloc_, 1);
+        try
+        {
+            NodeTraits::construct(alloc_, node, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            NodeTraits::deallocate(alloc_, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    /// Destroy an element node's value and release the node
+    void destroyNode(Node *node)
+    {
+        node->value.~T();
+        destroySentinel(node);
+    }
+
+    void destroySentinel(Node *node)
+    {
+        NodeTraits::destroy(alloc_, node);
+        NodeTraits::deallocate(alloc_, node, 1);
+    }
+
+    /// Free every node of a retire stack; returns how many
+    size_type destroyStack(Node *node)
+    {
+        size_type count = 0;
+        while (node)
+        {
+            Node *next = node->limbo;
+            destroyNode(node);
+            node = next;
+            ++count;
+        }
+        return count;
+    }
+
+    /// Register a reader in the current epoch; returns the slot to leave
+    int enterRead() const
+    {
+        for (;;)
+        {
+            std::size_t epoch = epoch_.load();
+            ReaderSlot &slot = readers_[epoch & 1];
+            slot.count.fetch_add(1);
+            if (epoch_.load() == epoch)
+                return static_cast<int>(epoch & 1);
+            slot.count.fetch_sub(1); // Raced with an epoch flip; retry
+        }
+    }
+
+    void leaveRead(int slot) const
+    {
+        readers_[slot].count.fetch_sub(1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Advance the epoch if the previous epoch's readers are gone.
+     *
+     * Never waits: returns 0 at once if another thread is advancing. On
+     * success, frees the stack retired two epochs back.
+     *
+     * A writer may push onto a stack with an epoch it read before this
+     * advance; its node was unlinked before that read, so every reader that
+     * could reach it is accounted for by the time the stack is taken, and a
+     * push landing after the take simply waits for a later advance.
+     *
+     * @return Number of nodes freed
+     */
+    size_type tryAdvance()
+    {
+        if (advancing_.exchange(true, std::memory_order_acquire))
+            return 0;
+        Node *dead = nullptr;
+        std::size_t epoch = epoch_.load();
+        std::size_t older = (epoch + 1) & 1; // Parity of epoch - 1
+        if (readers_[older].count.load() == 0)
+        {
+            dead = limbo_[older].exchange(nullptr, std::memory_order_acquire);
+            epoch_.store(epoch + 1);
+        }
+        advancing_.store(false, std::memory_order_release);
+        return destroyStack(dead);
+    }
+
+    /**
+     * @brief Park an unlinked node until no reader can still reach it.
+     *
+     * One CAS onto the current epoch's retire stack; cannot throw. Every
+     * kAdvanceInterval-th call on this list also tries to advance the epoch.
+     */
+    void retire(Node *node)
+    {
+        std::atomic<Node *> &stack = limbo_[epoch_.load() & 1];
+        node->limbo = stack.load(std::memory_order_relaxed);
+        while (!stack.compare_exchange_weak(node->limbo, node, std::memory_order_release,
+                                            std::memory_order_relaxed))
+        {
+        }
+        if ((retired_.fetch_add(1, std::memory_order_relaxed) + 1) % kAdvanceInterval == 0)
+            tryAdvance();
+    }
+
+    /// Link @p node just before @p succ (caller is inside a read epoch)
+    void linkBefore(Node *succ, Node *node)
+    {
+        for (;;)
+        {
+            Node *pred = succ->prev.load();
+            pred->lock();
+            succ->lock();
+            if (!pred->erased && !succ->erased && pred->next.load() == succ)
+            {
+                node->prev.ptr.store(pred, std::memory_order_relaxed);
+                node->next.ptr.store(succ, std::memory_order_relaxed);
+                // CRITICAL: Update Ref CONTENTS; readers see node fully built
+                pred->next.store(node);
+                succ->prev.store(node);
+                size_.fetch_add(1, std::memory_order_relaxed);
+                succ->unlock();
+                pred->unlock();
+                return;
+            }
+            succ->unlock();
+            pred->unlock();
+        }
+    }
+
+    /// Link @p node just after @p pred (caller is inside a read epoch)
+    void linkAfter(Node *pred, Node *node)
+    {
+        for (;;)
+        {
+            Node *succ = pred->next.load();
+            pred->lock();
+            succ->lock();
+            if (!pred->erased && !succ->erased && succ->prev.load() == pred)
+            {
+                node->prev.ptr.store(pred, std::memory_order_relaxed);
+                node->next.ptr.store(succ, std::memory_order_relaxed);
+                pred->next.store(node);
+                succ->prev.store(node);
+                size_.fetch_add(1, std::memory_order_relaxed);
+                succ->unlock();
+                pred->unlock();
+                return;
+            }
+            succ->unlock();
+            pred->unlock();
+        }
+    }
+
+    /**
+     * @brief Unlink @p node (caller is inside a read epoch).
+     * @return false if another thread erased it first
+     */
+    bool unlink(Node *node)
+    {
+        for (;;)
+        {
+            Node *pred = node->prev.load();
+            pred->lock();
+            node->lock();
+            if (node->erased)
+            {
+                node->unlock();
+                pred->unlock();
+                return false;
+            }
+            if (pred->erased || node->prev.load() != pred)
+            {
+                node->unlock();
+                pred->unlock();
+                continue; // Predecessor changed under us; retry
+            }
+            // node is locked and live, so its successor's prev is node
+            Node *succ = node->next.load();
+            succ->lock();
+            // CRITICAL: Update Ref CONTENTS, not the erased node's own slots
+            pred->next.store(succ); // A->B->C becomes A->C
+            succ->prev.store(pred); // C's prev updated from B to A
+            node->erased = true;
+            succ->unlock();
+            node->unlock();
+            pred->unlock();
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            retire(node);
+            return true;
+        }
+    }
+
+public:
+    // ========================================================================
+    // READ GUARD
+    // ========================================================================
+
+    /**
+     * @brief RAII registration in the current read epoch.
+     *
+     * Every node reachable while the guard is alive stays allocated until
+     * it is released. Iterators hold one automatically.
+     */
+    class ReadGuard
+    {
+        friend class ConcurrentMutableList;
+        const ConcurrentMutableList *list_ = nullptr;
+        int slot_ = -1;
+
+    public:
+        ReadGuard() = default;
+        explicit ReadGuard(const ConcurrentMutableList &list)
+            : list_(&list), slot_(list.enterRead())
+        {
+        }
+
+        ReadGuard(const ReadGuard &) = delete;
+        ReadGuard &operator=(const ReadGuard &) = delete;
+
+        ReadGuard(ReadGuard &&other) noexcept : list_(other.list_), slot_(other.slot_)
+        {
+            other.slot_ = -1;
+        }
+
+        ReadGuard &operator=(ReadGuard &&other) noexcept
+        {
+            std::swap(list_, other.list_);
+            std::swap(slot_, other.slot_);
+            return *this;
+        }
+
+        ~ReadGuard()
+        {
+            if (slot_ >= 0)
+                list_->leaveRead(slot_);
+        }
+
+        /// Whether this guard is currently registered
+        bool active() const { return slot_ >= 0; }
+    };
+
+    // ========================================================================
+    // ITERATOR
+    // ========================================================================
+
+    /**
+     * @brief Bidirectional const iterator holding its own read guard.
+     *
+     * Stepping is two acquire loads and never locks. end() starts without a
+     * guard (it stands on a sentinel) and registers the first time it is
+     * moved onto an element.
+     *
+     * While writers run, begin() is only a snapshot: a backward walk must
+     * not use it as its stop condition, since the front may be erased
+     * under it. Forward walks always reach end().
+     */
+    class const_iterator
+    {
+        friend class ConcurrentMutableList;
+        Node *current_ = nullptr;
+        ReadGuard guard_;
+
+        const_iterator(Node *node, ReadGuard guard) : current_(node), guard_(std::move(guard)) {}
+
+        void ensureGuard()
+        {
+            if (!guard_.active())
+                guard_ = ReadGuard(*guard_.list_);
+        }
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = const T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T *;
+        using reference = const T &;
+
+        const_iterator() = default;
+
+        const_iterator(const const_iterator &other) : current_(other.current_)
+        {
+            guard_.list_ = other.guard_.list_;
+            if (other.guard_.active())
+                guard_ = ReadGuard(*other.guard_.list_);
+        }
+
+        const_iterator(const_iterator &&other) noexcept = default;
+
+        const_iterator &operator=(const_iterator other) noexcept
+        {
+            std::swap(current_, other.current_);
+            guard_ = std::move(other.guard_);
+            return *this;
+        }
+
+        reference operator*() const { return current_->value; }
+        pointer operator->() const { return &current_->value; }
+
+        const_iterator &operator++()
+        {
+            ensureGuard();
+            current_ = current_->next.load();
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        const_iterator &operator--()
+        {
+            ensureGuard();
+            current_ = current_->prev.load();
+            return *this;
+        }
+
+        const_iterator operator--(int)
+        {
+            const_iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator &o) const { return current_ == o.current_; }
+        bool operator!=(const const_iterator &o) const { return current_ != o.current_; }
+    };
+
+    using iterator = const_iterator;
+
+    // ========================================================================
+    // CONSTRUCTION / DESTRUCTION
+    // ========================================================================
+
+    ConcurrentMutableList() : ConcurrentMutableList(Allocator()) {}
+
+    explicit ConcurrentMutableList(const Allocator &alloc)
+        : alloc_(alloc), head_(makeSentinel()), tail_(makeSentinel())
+    {
+        head_->next.store(tail_);
+        tail_->prev.store(head_);
+    }
+
+    ConcurrentMutableList(std::initializer_list<T> init, const Allocator &alloc = Allocator())
+        : ConcurrentMutableList(alloc)
+    {
+        for (const auto &v : init)
+            push_back(v);
+    }
+
+    ConcurrentMutableList(const ConcurrentMutableList &) = delete;
+    ConcurrentMutableList &operator=(const ConcurrentMutableList &) = delete;
+
+    /// Destructor: no other thread may use the list or hold its iterators
+    ~ConcurrentMutableList()
+    {
+        for (std::atomic<Node *> &stack : limbo_)
+            destroyStack(stack.load(std::memory_order_acquire));
+        for (Node *node = head_->next.load(); node != tail_;)
+        {
+            Node *next = node->next.load();
+            destroyNode(node);
+            node = next;
+        }
+        destroySentinel(head_);
+        destroySentinel(tail_);
+    }
+
+    allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+    // ========================================================================
+    // ITERATORS
+    // ========================================================================
+
+    const_iterator begin() const
+    {
+        ReadGuard guard(*this);
+        Node *first = head_->next.load();
+        return const_iterator(first, std::move(guard));
+    }
+
+    const_iterator end() const
+    {
+        ReadGuard unregistered;
+        unregistered.list_ = this;
+        return const_iterator(tail_, std::move(unregistered));
+    }
+
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    /// Visit every element under a single read guard
+    template <typename F>
+    void for_each(F f) const
+    {
+        ReadGuard guard(*this);
+        for (Node *node = head_->next.load(); node != tail_; node = node->next.load())
+            f(static_cast<const T &>(node->value));
+    }
+
+    // ========================================================================
+    // CAPACITY
+    // ========================================================================
+
+    [[nodiscard]] bool empty() const { return size() == 0; }
+    [[nodiscard]] size_type size() const { return size_.load(std::memory_order_relaxed); }
+
+    // ========================================================================
+    // MODIFIERS
+    // ========================================================================
+
+    /// Construct an element at the end; safe against concurrent writers
+    template <typename... Args>
+    void emplace_back(Args &&...args)
+    {
+        Node *node = makeNode(std::forward<Args>(args)...);
+        ReadGuard guard(*this);
+        linkBefore(tail_, node);
+    }
+
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    /// Construct an element at the beginning; safe against concurrent writers
+    template <typename... Args>
+    void emplace_front(Args &&...args)
+    {
+        Node *node = makeNode(std::forward<Args>(args)...);
+        ReadGuard guard(*this);
+        linkAfter(head_, node);
+    }
+
+    void push_front(const T &value) { emplace_front(value); }
+    void push_front(T &&value) { emplace_front(std::move(value)); }
+
+    /**
+     * @brief Erase the element at @p pos.
+     *
+     * **SAFE DURING ITERATION** on any thread: @p pos (and every other
+     * iterator) keeps stepping correctly from the erased node.
+     *
+     * @return false if another thread already erased it
+     */
+    bool erase(const const_iterator &pos)
+    {
+        ReadGuard guard(*this);
+        return unlink(pos.current_);
+    }
+
+    /**
+     * @brief Remove the first element, copying it to @p out.
+     *
+     * The value is copied rather than moved because readers may still be
+     * looking at the node.
+     *
+     * @return false if the list was empty
+     */
+    bool try_pop_front(T &out)
+    {
+        ReadGuard guard(*this);
+        for (;;)
+        {
+            Node *first = head_->next.load();
+            if (first == tail_)
+                return false;
+            if (unlink(first))
+            {
+                out = first->value;
+                return true;
+            }
+        }
+    }
+
+    /// Erase every element matching @p pred; returns how many this call removed
+    template <typename Pred>
+    size_type erase_if(Pred pred)
+    {
+        ReadGuard guard(*this);
+        size_type removed = 0;
+        for (Node *node = head_->next.load(); node != tail_; node = node->next.load())
+        {
+            if (pred(static_cast<const T &>(node->value)) && unlink(node))
+                ++removed;
+        }
+        return removed;
+    }
+
+    /// Free erased nodes whose readers are all gone; returns how many
+    size_type try_reclaim() { return tryAdvance(); }
+};
+
+#endif // MUTABLE_CHAIN_CONCURRENT_HPP
@@ -0,0 +1,246 @@
+/**
+ * @file mutable_chain_coro.hpp
+ * @brief C++20 coroutine traversal: MutableList and the C chain as batch generators
+ *
+ * batches(list, n) is a coroutine that walks a MutableList<T> and yields
+ * its elements in batches of up to @p n pointers. Between batches the
+ * coroutine is suspended with its iterator parked in the frame, so a
+ * pipeline stage can send one batch over the network, erase or append
+ * elements, and pull the next batch when it is ready. The traversal picks
+ * up where it stopped, with the usual MutableList contract:
+ * - the parked iterator pins the list, so elements erased while the
+ *   generator is suspended (including ones in the batch just yielded)
+ *   stay readable until the generator is destroyed;
+ * - the walk resumes from the successor of the last element yielded, even
+ *   if that element has been erased since.
+ *
+ * batches(initial, n) does the same over a C chain with a ChainCursor. As
+ * with link_iterator, removed nodes must not be freed until the
+ * traversal is finished.
+ *
+ * Only available in C++20 builds: configure with
+ * -DMUTABLE_CHAIN_ENABLE_COROUTINES=ON.
+ *
+ * @code
+ *     for (const auto &batch : batches(events, 256))
+ *     {
+ *         socket.send(batch);                           // Traversal suspended meanwhile
+ *         events.erase_if([](const Event &e) { return e.acked; });
+ *     }
+ * @endcode
+ */
+
+#ifndef MUTABLE_CHAIN_CORO_HPP
+#define MUTABLE_CHAIN_CORO_HPP
+
+#if !defined(__cpp_impl_coroutine) || !__has_include(<coroutine>)
+#error "mutable_chain_coro.hpp needs C++20 coroutines (set MUTABLE_CHAIN_ENABLE_COROUTINES=ON)"
+#endif
+
+#include "mutable_chain.h"
+#include "mutable_chain.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Move-only pull generator yielding references to @p Y.
+ *
+ * Each yielded value lives in the coroutine frame and stays valid until the
+ * generator is resumed again. The coroutine body runs only when the
+ * consumer advances, so nothing is buffered ahead of it. Exceptions thrown
+ * by the body surface from begin() or operator++.
+ *
+ * @tparam Y The yielded type
+ */
+template <typename Y>
+class ChainGenerator
+{
+public:
+    struct promise_type
+    {
+        Y *current = nullptr;     ///< Value of the last co_yield
+        std::exception_ptr error; ///< Exception escaping the body
+
+        ChainGenerator get_return_object()
+        {
+            return ChainGenerator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        std::suspend_always yield_value(Y &value) noexcept
+        {
+            current = std::addressof(value);
+            return {};
+        }
+
+        void return_void() noexcept {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+private:
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Handle coro_; ///< Suspended traversal (null once moved from)
+
+    explicit ChainGenerator(Handle coro) : coro_(coro) {}
+
+    /// Run the body to its next co_yield (or its end)
+    void advance()
+    {
+        coro_.resume();
+        if (coro_.promise().error)
+            std::rethrow_exception(std::exchange(coro_.promise().error, nullptr));
+    }
+
+public:
+    /// Input iterator over the yielded values
+    class iterator
+    {
+        friend class ChainGenerator;
+        ChainGenerator *gen_ = nullptr;
+
+        explicit iterator(ChainGenerator *gen) : gen_(gen) {}
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Y;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Y *;
+        using reference = Y &;
+
+        iterator() = default;
+
+        reference operator*() const { return *gen_->coro_.promise().current; }
+        pointer operator->() const { return gen_->coro_.promise().current; }
+
+        iterator &operator++()
+        {
+            gen_->advance();
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        bool operator==(std::default_sentinel_t) const { return gen_->coro_.done(); }
+    };
+
+    ChainGenerator(const ChainGenerator &) = delete;
+    ChainGenerator &operator=(const ChainGenerator &) = delete;
+
+    ChainGenerator(ChainGenerator &&other) noexcept : coro_(std::exchange(other.coro_, nullptr)) {}
+
+    ChainGenerator &operator=(ChainGenerator &&other) noexcept
+    {
+        std::swap(coro_, other.coro_);
+        return *this;
+    }
+
+    /// Destroying a suspended generator ends the traversal (and drops its pin)
+    ~ChainGenerator()
+    {
+        if (coro_)
+            coro_.destroy();
+    }
+
+    /// Start the traversal: runs the body up to its first co_yield
+    iterator begin()
+    {
+        advance();
+        return iterator(this);
+    }
+
+    std::default_sentinel_t end() const { return {}; }
+};
+
+/// One batch of elements: pointers into the list, in traversal order
+template <typename T>
+using ChainBatch = std::vector<T *>;
+
+/**
+ * @brief Walk @p list front to back, yielding up to @p batch_size elements at a time.
+ *
+ * The list must outlive the generator. Elements appended while it is
+ * suspended are visited if they land after the parked iterator. A
+ * @p batch_size of 0 is treated as 1, rather than buffering the whole list.
+ */
+template <typename T, typename A, typename S>
+ChainGenerator<ChainBatch<T>> batches(MutableList<T, A, S> &list, std::size_t batch_size)
+{
+    if (batch_size == 0)
+        batch_size = 1;
+    ChainBatch<T> batch;
+    batch.reserve(batch_size);
+    auto it = list.begin(); // Outlives the loop: its pin also covers the last batch
+    for (; it != list.end(); ++it)
+    {
+        batch.push_back(&*it);
+        if (batch.size() == batch_size)
+        {
+            co_yield batch; // Suspended here; it keeps the list pinned
+            batch.clear();
+        }
+    }
+    if (!batch.empty())
+        co_yield batch;
+}
+
+/// Read-only walk of @p list in batches of up to @p batch_size elements (0 is treated as 1)
+template <typename T, typename A, typename S>
+ChainGenerator<ChainBatch<const T>> batches(const MutableList<T, A, S> &list,
+                                              std::size_t batch_size)
+{
+    if (batch_size == 0)
+        batch_size = 1;
+    ChainBatch<const T> batch;
+    batch.reserve(batch_size);
+    auto it = list.begin();
+    for (; it != list.end(); ++it)
+    {
+        batch.push_back(&*it);
+        if (batch.size() == batch_size)
+        {
+            co_yield batch;
+            batch.clear();
+        }
+    }
+    if (!batch.empty())
+        co_yield batch;
+}
+
+/**
+ * @brief Walk the C chain after @p a_link, yielding up to @p batch_size nodes at a time.
+ *
+ * Same contract as link_iterator and ChainCursor: nodes may be unlinked
+ * with link_data_remove while the generator is suspended, but not freed
+ * until it has finished. A @p batch_size of 0 is treated as 1.
+ */
+inline ChainGenerator<ChainBatch<Node>> batches(Node *a_link, std::size_t batch_size,
+                                                bool reverse = false)
+{
+    if (batch_size == 0)
+        batch_size = 1;
+    ChainBatch<Node> batch;
+    batch.reserve(batch_size);
+    ChainCursor cursor = chain_cursor_begin(a_link, reverse);
+    while (Node *node = chain_cursor_next(&cursor))
+    {
+        batch.push_back(node);
+        if (batch.size() == batch_size)
+        {
+            co_yield batch;
+            batch.clear();
+        }
+    }
+    if (!batch.empty())
+        co_yield batch;
+}
+
+#endif // MUTABLE_CHAIN_CORO_HPP
@@ -0,0 +1,544 @@
+/**
+ * @file mutable_chain_handles.hpp
+ * @brief MutableList with generational handles for external references
+ *
+ * HandleMutableList<T> hands out a ListHandle from every insert: an 8-byte
+ * (index, generation) pair naming one element. Handles can be stored
+ * anywhere (other containers, other threads' queues, files) without
+ * pinning the list or keeping erased nodes alive, and a stale one is
+ * detected in O(1): erasing an element bumps the generation of its slot,
+ * so every handle to it stops matching.
+ *
+ * @section handleslots SLOT TABLE
+ *
+ * The list keeps a slot table alongside the chain. Slot i holds the node
+ * currently named by index i and the generation it was issued under; free
+ * slots form a LIFO list and are reused by later inserts with the next
+ * generation. Each node records its slot index next to its value, so
+ * erasing through an iterator (or erase_if) frees the right slot too.
+ *
+ * @code
+ *     HandleMutableList<Order> orders;
+ *     ListHandle h = orders.push_back(order);   // Store h in a hash map, a heap, ...
+ *     if (Order *o = orders.get(h))             // nullptr once the order is gone
+ *         o->qty -= fill;
+ *     orders.erase(h);                           // O(1); false if already erased
+ * @endcode
+ *
+ * Iteration, erase while iterating and erase_if behave as in MutableList.
+ */
+
+#ifndef MUTABLE_CHAIN_HANDLES_HPP
+#define MUTABLE_CHAIN_HANDLES_HPP
+
+#include "mutable_chain.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Stable, trivially copyable reference to one HandleMutableList element.
+ *
+ * A default-constructed handle is null and never names an element.
+ */
+struct ListHandle
+{
+    std::uint32_t index = 0;      ///< Slot in the list's slot table
+    std::uint32_t generation = 0; ///< Issue count of that slot (0 = null)
+
+    explicit operator bool() const { return generation != 0; }
+
+    bool operator==(const ListHandle &o) const
+    {
+        return index == o.index && generation == o.generation;
+    }
+    bool operator!=(const ListHandle &o) const { return !(*this == o); }
+};
+
+/**
+ * @brief Doubly-linked list whose elements are named by generational handles.
+ *
+ * Generations are 32-bit: a handle could only be confused with a newer
+ * element after its slot has been reused 2^32 times.
+ *
+ * @tparam T Element type
+ * @tparam Allocator Allocator for the nodes and the slot table
+ */
+template <typename T, typename Allocator = std::allocator<T>>
+class HandleMutableList
+{
+    /// Stored value plus the slot that names it
+    struct Entry
+    {
+        T value;
+        std::uint32_t slot;
+
+        template <typename... Args>
+        explicit Entry(std::uint32_t s, Args &&...args) : value(std::forward<Args>(args)...), slot(s)
+        {
+        }
+    };
+
+    using EntryAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Entry>;
+    using List = MutableList<Entry, EntryAllocator>;
+    using Node = ListNode<Entry>;
+
+    static constexpr std::uint32_t kNoSlot = ~std::uint32_t(0);
+
+    /// One slot table entry: the node it names now, or the next free slot
+    struct Slot
+    {
+        Node *node;               ///< Named node (nullptr while free)
+        std::uint32_t generation; ///< Generation of the handle issued for node
+        std::uint32_t next_free;  ///< Next free slot (valid while free)
+    };
+
+    using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+
+public:
+    // ========================================================================
+    // STL TYPE ALIASES
+    // ========================================================================
+    using value_type = T;                       ///< Element type
+    using allocator_type = Allocator;           ///< Allocator type
+    using size_type = std::size_t;              ///< Unsigned integer type for sizes
+    using difference_type = std::ptrdiff_t;     ///< Signed integer type for differences
+    using reference = value_type &;             ///< Reference to element
+    using const_reference = const value_type &; ///< Const reference to element
+    using handle_type = ListHandle;             ///< External reference type
+
+    // ========================================================================
+    // ITERATOR
+    // ========================================================================
+
+    /**
+     * @brief MutableList iterator projected onto the element value.
+     *
+     * Keeps all MutableList iterator guarantees (pinning, erase while
+     * iterating); HandleMutableList::handle(it) names the element it
+     * stands on.
+     */
+    template <typename BaseIt, typename V>
+    class IteratorImpl
+    {
+        friend class HandleMutableList;
+        template <typename, typename>
+        friend class IteratorImpl;
+
+        BaseIt it_;
+
+        explicit IteratorImpl(BaseIt it) : it_(std::move(it)) {}
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = V;
+        using difference_type = std::ptrdiff_t;
+        using pointer = V *;
+        using reference = V &;
+
+        IteratorImpl() = default;
+
+        /// Allow conversion from non-const to const iterator
+        template <typename OtherIt, typename W,
+                  typename = std::enable_if_t<std::is_convertible<OtherIt, BaseIt>::value>>
+        IteratorImpl(const IteratorImpl<OtherIt, W> &other) : it_(other.it_)
+        {
+        }
+
+        reference operator*() const { return it_->value; }
+        pointer operator->() const { return &it_->value; }
+
+        IteratorImpl &operator++()
+        {
+            ++it_;
+            return *this;
+        }
+        IteratorImpl operator++(int)
+        {
+            IteratorImpl tmp = *this;
+            ++it_;
+            return tmp;
+        }
+        IteratorImpl &operator--()
+        {
+            --it_;
+            return *this;
+        }
+        IteratorImpl operator--(int)
+        {
+            IteratorImpl tmp = *this;
+            --it_;
+            return tmp;
+        }
+
+        template <typename OtherIt, typename W>
+        bool operator==(const IteratorImpl<OtherIt, W> &o) const { return it_ == o.it_; }
+        template <typename OtherIt, typename W>
+        bool operator!=(const IteratorImpl<OtherIt, W> &o) const { return it_ != o.it_; }
+    };
+
+    using iterator = IteratorImpl<typename List::iterator, T>;
+    using const_iterator = IteratorImpl<typename List::const_iterator, const T>;
+    using reverse_iterator = IteratorImpl<typename List::reverse_iterator, T>;
+    using const_reverse_iterator = IteratorImpl<typename List::const_reverse_iterator, const T>;
+
+private:
+    List list_;                              ///< The elements, in order
+    std::vector<Slot, SlotAllocator> slots_; ///< Handle index -> node
+    std::uint32_t free_ = kNoSlot;           ///< Head of the free slot list
+
+    /// Take a free slot (or grow the table); its generation is already the next one
+    std::uint32_t acquireSlot()
+    {
+        if (free_ != kNoSlot)
+        {
+            std::uint32_t index = free_;
+            free_ = slots_[index].next_free;
+            return index;
+        }
+        slots_.push_back(Slot{nullptr, 1, kNoSlot});
+        return static_cast<std::uint32_t>(slots_.size() - 1);
+    }
+
+    /// Return @p index to the free list, invalidating its handles
+    void releaseSlot(std::uint32_t index)
+    {
+        Slot &slot = slots_[index];
+        slot.node = nullptr;
+        if (++slot.generation == 0) // Generation 0 is reserved for null handles
+            slot.generation = 1;
+        slot.next_free = free_;
+        free_ = index;
+    }
+
+    /// Record the node just linked for @p index and issue its handle
+    ListHandle bind(std::uint32_t index, Node *node)
+    {
+        slots_[index].node = node;
+        return ListHandle{index, slots_[index].generation};
+    }
+
+    /// Node named by @p h, or nullptr if @p h is stale or null
+    Node *resolve(const ListHandle &h) const
+    {
+        if (h.index >= slots_.size())
+            return nullptr;
+        const Slot &slot = slots_[h.index];
+        return slot.generation == h.generation ? slot.node : nullptr;
+    }
+
+    /// Unlink @p node and free its slot
+    void eraseNode(Node *node)
+    {
+        releaseSlot(node->value.slot);
+        list_.erase_node(node);
+    }
+
+    /// Point every live slot at the corresponding node of list_ (after a copy)
+    void rebind()
+    {
+        for (auto it = list_.begin(); it != list_.end(); ++it)
+            slots_[it->slot].node = it.node();
+    }
+
+public:
+    // ========================================================================
+    // CONSTRUCTION / DESTRUCTION
+    // ========================================================================
+
+    /// Default constructor: empty list, empty slot table
+    HandleMutableList() : HandleMutableList(Allocator()) {}
+
+    /// Allocator constructor: nodes and slots come from @p alloc
+    explicit HandleMutableList(const Allocator &alloc)
+        : list_(EntryAllocator(alloc)), slots_(SlotAllocator(alloc))
+    {
+    }
+
+    /// Initializer list constructor
+    HandleMutableList(std::initializer_list<T> init, const Allocator &alloc = Allocator())
+        : HandleMutableList(alloc)
+    {
+        slots_.reserve(init.size());
+        for (const T &value : init)
+            push_back(value);
+    }
+
+    /// Copy constructor: every handle into @p other also names the copy's element
+    HandleMutableList(const HandleMutableList &other)
+        : list_(other.list_), slots_(other.slots_), free_(other.free_)
+    {
+        rebind();
+    }
+
+    /// Move constructor: nodes do not move, so handles stay valid in the new list
+    HandleMutableList(HandleMutableList &&other)
+        : list_(std::move(other.list_)), slots_(std::move(other.slots_)), free_(other.free_)
+    {
+        other.slots_.clear();
+        other.free_ = kNoSlot;
+    }
+
+    /// Copy assignment (copy and swap)
+    HandleMutableList &operator=(const HandleMutableList &other)
+    {
+        if (this != &other)
+        {
+            HandleMutableList copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    /// Move assignment: takes @p other's nodes and slot table
+    HandleMutableList &operator=(HandleMutableList &&other)
+    {
+        if (this != &other)
+        {
+            HandleMutableList taken(std::move(other));
+            swap(taken);
+        }
+        return *this;
+    }
+
+    /// Swap contents (handles follow their elements)
+    void swap(HandleMutableList &other)
+    {
+        list_.swap(other.list_);
+        slots_.swap(other.slots_);
+        std::swap(free_, other.free_);
+    }
+
+    /// Get a copy of the allocator
+    allocator_type get_allocator() const { return allocator_type(list_.get_allocator()); }
+
+    // ========================================================================
+    // ITERATORS
+    // ========================================================================
+
+    iterator begin() { return iterator(list_.begin()); }
+    iterator end() { return iterator(list_.end()); }
+    const_iterator begin() const { return const_iterator(list_.begin()); }
+    const_iterator end() const { return const_iterator(list_.end()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    reverse_iterator rbegin() { return reverse_iterator(list_.rbegin()); }
+    reverse_iterator rend() { return reverse_iterator(list_.rend()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(list_.rbegin()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(list_.rend()); }
+    const_reverse_iterator crbegin() const { return rbegin(); }
+    const_reverse_iterator crend() const { return rend(); }
+
+    // ========================================================================
+    // CAPACITY
+    // ========================================================================
+
+    /// Check if the list is empty
+    [[nodiscard]] bool empty() const { return list_.empty(); }
+
+    /// Get the number of elements
+    [[nodiscard]] size_type size() const { return list_.size(); }
+
+    /// Size the slot table for @p count live handles
+    void reserve(size_type count) { slots_.reserve(count); }
+
+    // ========================================================================
+    // ELEMENT ACCESS AND HANDLES
+    // ========================================================================
+
+    /// Access the first element
+    reference front() { return list_.front().value; }
+    const_reference front() const { return list_.front().value; }
+
+    /// Access the last element
+    reference back() { return list_.back().value; }
+    const_reference back() const { return list_.back().value; }
+
+    /// Check in O(1) whether @p h still names an element
+    bool contains(const ListHandle &h) const { return resolve(h) != nullptr; }
+
+    /// The element named by @p h, or nullptr if it has been erased
+    T *get(const ListHandle &h)
+    {
+        Node *node = resolve(h);
+        return node ? &node->value.value : nullptr;
+    }
+    const T *get(const ListHandle &h) const
+    {
+        Node *node = resolve(h);
+        return node ? &node->value.value : nullptr;
+    }
+
+    /// Iterator to the element named by @p h, or end() if it has been erased
+    iterator find(const ListHandle &h)
+    {
+        Node *node = resolve(h);
+        return node ? iterator(list_.iterator_to(node)) : end();
+    }
+    const_iterator find(const ListHandle &h) const
+    {
+        Node *node = resolve(h);
+        return node ? const_iterator(list_.iterator_to(node)) : end();
+    }
+
+    /// Handle naming the element at @p pos
+    ListHandle handle(const const_iterator &pos) const
+    {
+        std::uint32_t index = pos.it_->slot;
+        return ListHandle{index, slots_[index].generation};
+    }
+
+    // ========================================================================
+    // MODIFIERS
+    // ========================================================================
+
+    /**
+     * @brief Construct element in-place at the end.
+     * @return Handle naming the new element
+     */
+    template <typename... Args>
+    ListHandle emplace_back(Args &&...args)
+    {
+        std::uint32_t index = acquireSlot();
+        try
+        {
+            list_.emplace_back(index, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            releaseSlot(index);
+            throw;
+        }
+        return bind(index, (--list_.end()).node());
+    }
+
+    /// Add element to the end (copy)
+    ListHandle push_back(const T &value) { return emplace_back(value); }
+
+    /// Add element to the end (move)
+    ListHandle push_back(T &&value) { return emplace_back(std::move(value)); }
+
+    /**
+     * @brief Construct element in-place at the beginning.
+     * @return Handle naming the new element
+     */
+    template <typename... Args>
+    ListHandle emplace_front(Args &&...args)
+    {
+        std::uint32_t index = acquireSlot();
+        try
+        {
+            list_.emplace_front(index, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            releaseSlot(index);
+            throw;
+        }
+        return bind(index, list_.begin().node());
+    }
+
+    /// Add element to the beginning (copy)
+    ListHandle push_front(const T &value) { return emplace_front(value); }
+
+    /// Add element to the beginning (move)
+    ListHandle push_front(T &&value) { return emplace_front(std::move(value)); }
+
+    /// Remove the last element
+    void pop_back()
+    {
+        if (!empty())
+            eraseNode((--list_.end()).node());
+    }
+
+    /// Remove the first element
+    void pop_front()
+    {
+        if (!empty())
+            eraseNode(list_.begin().node());
+    }
+
+    /**
+     * @brief Erase the element named by @p h in O(1).
+     * @return false if @p h was stale or null (nothing is erased)
+     */
+    bool erase(const ListHandle &h)
+    {
+        Node *node = resolve(h);
+        if (!node)
+            return false;
+        eraseNode(node);
+        return true;
+    }
+
+    /// Erase element at iterator position (safe during iteration, as in MutableList)
+    iterator erase(const const_iterator &pos)
+    {
+        Node *node = pos.it_.node();
+        Node *succ = node->next.ptr;
+        eraseNode(node);
+        return iterator(list_.iterator_to(succ));
+    }
+
+    /// Erase every element matching @p pred in one pass; their handles go stale
+    template <typename Pred>
+    size_type erase_if(Pred pred)
+    {
+        return list_.erase_if([this, &pred](const Entry &entry) {
+            if (!pred(static_cast<const T &>(entry.value)))
+                return false;
+            releaseSlot(entry.slot);
+            return true;
+        });
+    }
+
+    /// Remove all elements; every handle goes stale
+    void clear()
+    {
+        for (auto it = list_.begin(); it != list_.end(); ++it)
+            releaseSlot(it->slot);
+        list_.clear();
+    }
+
+    /**
+     * @brief Reallocate the nodes in traversal order (see MutableList::compact).
+     *
+     * Handles stay valid: the slot table is pointed at the new nodes, so
+     * only raw pointers and references to elements are invalidated.
+     *
+     * @warning Refuses while any iterator of the list is alive, as
+     * MutableList::compact() does.
+     *
+     * @return false (nothing moves) while any iterator of the list is alive
+     */
+    [[nodiscard]] bool compact()
+    {
+        if (!list_.compact())
+            return false;
+        rebind();
+        return true;
+    }
+};
+
+/// Swap two handle lists
+template <typename T, typename A>
+void swap(HandleMutableList<T, A> &a, HandleMutableList<T, A> &b)
+{
+    a.swap(b);
+}
+
+/// Erase every element of @p list matching @p pred
+template <typename T, typename A, typename Pred>
+typename HandleMutableList<T, A>::size_type erase_if(HandleMutableList<T, A> &list, Pred pred)
+{
+    return list.erase_if(std::move(pred));
+}
+
+#endif // MUTABLE_CHAIN_HANDLES_HPP
@@ -0,0 +1,404 @@
+/**
+ * @file mutable_chain_indexed.hpp
+ * @brief MutableList with a hash index from values to nodes
+ *
+ * IndexedMutableList<T> is a MutableList<T> plus an unordered index keyed
+ * by the values themselves, kept in sync by every insert and erase. find()
+ * and erase(value) cost one hash lookup instead of a scan from begin().
+ *
+ * The index stores a pointer to each node's value (hashed and compared
+ * through Hash and KeyEqual) next to the node pointer, so values are not
+ * copied into it. That makes the values keys: they are reachable only
+ * through const references, like the elements of a std::unordered_set. To
+ * change a value, erase it and insert the new one.
+ *
+ * @section idxerase ERASE WHILE ITERATING
+ *
+ * Erasing goes through MutableList::erase_node, so iterators keep the
+ * MutableList contract: erase(find(id)) may remove the element an
+ * iterator is standing on, and that iterator still advances to the
+ * successor. An erased element leaves the index immediately, even if its
+ * node is retired until the last iterator goes.
+ *
+ * @code
+ *     IndexedMutableList<OrderId> book;
+ *     book.reserve(1 << 20);
+ *     for (OrderId id : incoming)
+ *         book.push_back(id);
+ *     book.erase(cancelled);      // O(1) on average, no scan
+ *     if (book.contains(id)) ...
+ * @endcode
+ */
+
+#ifndef MUTABLE_CHAIN_INDEXED_HPP
+#define MUTABLE_CHAIN_INDEXED_HPP
+
+#include "mutable_chain.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Insertion-ordered list with O(1) average find and erase by value.
+ *
+ * Equal values may appear more than once; find() returns one of them and
+ * erase(value) removes them all.
+ *
+ * @tparam T Element type (hashable with Hash, comparable with KeyEqual)
+ * @tparam Hash Hash function on T
+ * @tparam KeyEqual Equality on T
+ * @tparam Allocator Allocator for both the list nodes and the index
+ */
+template <typename T, typename Hash = std::hash<T>, typename KeyEqual = std::equal_to<T>,
+          typename Allocator = std::allocator<T>>
+class IndexedMutableList
+{
+    using List = MutableList<T, Allocator>;
+    using Node = ListNode<T>;
+
+    /// Hashes an index key (a pointer to a value) by the value it points to
+    struct KeyHash
+    {
+        Hash hash;
+        std::size_t operator()(const T *key) const { return hash(*key); }
+    };
+
+    /// Compares index keys by the values they point to
+    struct KeyEquals
+    {
+        KeyEqual equal;
+        bool operator()(const T *a, const T *b) const { return equal(*a, *b); }
+    };
+
+    using Entry = std::pair<const T *const, Node *>;
+    using Index = std::unordered_multimap<
+        const T *, Node *, KeyHash, KeyEquals,
+        typename std::allocator_traits<Allocator>::template rebind_alloc<Entry>>;
+    using NodePtrAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node *>;
+
+public:
+    // ========================================================================
+    // STL TYPE ALIASES
+    // ========================================================================
+    using value_type = T;                                    ///< Element type
+    using allocator_type = Allocator;                        ///< Allocator type
+    using hasher = Hash;                                     ///< Hash function type
+    using key_equal = KeyEqual;                              ///< Equality type
+    using size_type = typename List::size_type;              ///< Unsigned integer type for sizes
+    using difference_type = typename List::difference_type;  ///< Signed integer type for differences
+    using reference = const value_type &;                    ///< Elements are keys: always const
+    using const_reference = const value_type &;              ///< Const reference to element
+    using const_iterator = typename List::const_iterator;    ///< Bidirectional, read-only
+    using iterator = const_iterator;                         ///< Elements are keys: always const
+    using const_reverse_iterator = typename List::const_reverse_iterator;
+    using reverse_iterator = const_reverse_iterator;
+
+private:
+    List list_;   ///< The elements, in insertion order
+    Index index_; ///< &node->value -> node, for every linked node
+
+    /// Add the node just linked to the index, unlinking it again if that throws
+    const_reference indexNode(Node *node)
+    {
+        try
+        {
+            index_.emplace(&node->value, node);
+        }
+        catch (...)
+        {
+            list_.erase_node(node);
+            throw;
+        }
+        return node->value;
+    }
+
+    /// Remove the index entry of the node holding @p value
+    void unindex(const T *value)
+    {
+        auto range = index_.equal_range(value);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->first == value)
+            {
+                index_.erase(it);
+                return;
+            }
+        }
+    }
+
+    /// Index every node of list_ (after a copy)
+    void rebuildIndex()
+    {
+        index_.reserve(list_.size());
+        for (auto it = list_.begin(); it != list_.end(); ++it)
+            index_.emplace(&it.node()->value, it.node());
+    }
+
+public:
+    // ========================================================================
+    // CONSTRUCTION / DESTRUCTION
+    // ========================================================================
+
+    /// Default constructor: empty list and index
+    IndexedMutableList() : IndexedMutableList(Allocator()) {}
+
+    /// Allocator constructor: nodes and index entries come from @p alloc
+    explicit IndexedMutableList(const Allocator &alloc, const Hash &hash = Hash(),
+                                const KeyEqual &equal = KeyEqual())
+        : list_(alloc), index_(0, KeyHash{hash}, KeyEquals{equal}, alloc)
+    {
+    }
+
+    /// Initializer list constructor
+    IndexedMutableList(std::initializer_list<T> init, const Allocator &alloc = Allocator())
+        : IndexedMutableList(alloc)
+    {
+        index_.reserve(init.size());
+        for (const T &value : init)
+            push_back(value);
+    }
+
+    /// Copy constructor (the copy gets its own index)
+    IndexedMutableList(const IndexedMutableList &other)
+        : list_(other.list_),
+          index_(0, other.index_.hash_function(), other.index_.key_eq(), list_.get_allocator())
+    {
+        rebuildIndex();
+    }
+
+    /// Move constructor: nodes do not move, so the index moves with them
+    IndexedMutableList(IndexedMutableList &&other)
+        : list_(std::move(other.list_)), index_(std::move(other.index_))
+    {
+        other.index_.clear();
+    }
+
+    /// Copy assignment (copy and swap)
+    IndexedMutableList &operator=(const IndexedMutableList &other)
+    {
+        if (this != &other)
+        {
+            IndexedMutableList copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    /// Move assignment: takes @p other's nodes and index
+    IndexedMutableList &operator=(IndexedMutableList &&other)
+    {
+        if (this != &other)
+        {
+            IndexedMutableList taken(std::move(other));
+            swap(taken);
+        }
+        return *this;
+    }
+
+    /// Swap contents (elements, index, hash and equality) with another list
+    void swap(IndexedMutableList &other)
+    {
+        list_.swap(other.list_);
+        index_.swap(other.index_);
+    }
+
+    /// Get a copy of the allocator
+    allocator_type get_allocator() const { return list_.get_allocator(); }
+
+    /// Read-only access to the underlying list
+    const List &list() const { return list_; }
+
+    // ========================================================================
+    // ITERATORS
+    // ========================================================================
+
+    const_iterator begin() const { return list_.begin(); }
+    const_iterator end() const { return list_.end(); }
+    const_iterator cbegin() const { return list_.begin(); }
+    const_iterator cend() const { return list_.end(); }
+    const_reverse_iterator rbegin() const { return list_.rbegin(); }
+    const_reverse_iterator rend() const { return list_.rend(); }
+    const_reverse_iterator crbegin() const { return list_.rbegin(); }
+    const_reverse_iterator crend() const { return list_.rend(); }
+
+    // ========================================================================
+    // CAPACITY
+    // ========================================================================
+
+    /// Check if the list is empty
+    [[nodiscard]] bool empty() const { return list_.empty(); }
+
+    /// Get the number of elements
+    [[nodiscard]] size_type size() const { return list_.size(); }
+
+    /// Size the index for @p count elements, so filling it never rehashes
+    void reserve(size_type count) { index_.reserve(count); }
+
+    // ========================================================================
+    // ELEMENT ACCESS AND LOOKUP
+    // ========================================================================
+
+    /// Access the first element
+    const_reference front() const { return list_.front(); }
+
+    /// Access the last element
+    const_reference back() const { return list_.back(); }
+
+    /// Iterator to an element equal to @p value, or end() if there is none
+    const_iterator find(const T &value) const
+    {
+        auto entry = index_.find(&value);
+        return entry == index_.end() ? end() : list_.iterator_to(entry->second);
+    }
+
+    /// Check whether an element equal to @p value is present
+    bool contains(const T &value) const { return index_.find(&value) != index_.end(); }
+
+    /// Number of elements equal to @p value
+    size_type count(const T &value) const { return index_.count(&value); }
+
+    // ========================================================================
+    // MODIFIERS
+    // ========================================================================
+
+    /**
+     * @brief Construct element in-place at the end and index it.
+     * @return Reference to the inserted element
+     */
+    template <typename... Args>
+    const_reference emplace_back(Args &&...args)
+    {
+        list_.emplace_back(std::forward<Args>(args)...);
+        return indexNode((--list_.end()).node());
+    }
+
+    /// Add element to the end (copy)
+    void push_back(const T &value) { emplace_back(value); }
+
+    /// Add element to the end (move)
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    /**
+     * @brief Construct element in-place at the beginning and index it.
+     * @return Reference to the inserted element
+     */
+    template <typename... Args>
+    const_reference emplace_front(Args &&...args)
+    {
+        list_.emplace_front(std::forward<Args>(args)...);
+        return indexNode(list_.begin().node());
+    }
+
+    /// Add element to the beginning (copy)
+    void push_front(const T &value) { emplace_front(value); }
+
+    /// Add element to the beginning (move)
+    void push_front(T &&value) { emplace_front(std::move(value)); }
+
+    /// Remove the last element
+    void pop_back()
+    {
+        if (!empty())
+            erase_node((--list_.end()).node());
+    }
+
+    /// Remove the first element
+    void pop_front()
+    {
+        if (!empty())
+            erase_node(list_.begin().node());
+    }
+
+    /// Erase element at iterator position (safe during iteration, as in MutableList)
+    const_iterator erase(const const_iterator &pos)
+    {
+        Node *succ = pos.node()->next.ptr;
+        erase_node(pos.node());
+        return list_.iterator_to(succ);
+    }
+
+    /// Erase element by node pointer, removing its index entry
+    void erase_node(Node *node)
+    {
+        unindex(&node->value);
+        list_.erase_node(node);
+    }
+
+    /**
+     * @brief Erase every element equal to @p value.
+     *
+     * One hash lookup plus O(1) per element removed. @p value may refer to
+     * an element of this list.
+     *
+     * @return Number of elements removed
+     */
+    size_type erase(const T &value)
+    {
+        auto range = index_.equal_range(&value);
+        if (range.first == range.second)
+            return 0;
+        if (std::next(range.first) == range.second)
+        {
+            Node *node = range.first->second;
+            index_.erase(range.first);
+            list_.erase_node(node);
+            return 1;
+        }
+        // Collect first: erasing a node may release the storage @p value lives in
+        std::vector<Node *, NodePtrAllocator> nodes{NodePtrAllocator(list_.get_allocator())};
+        nodes.reserve(static_cast<std::size_t>(std::distance(range.first, range.second)));
+        for (auto it = range.first; it != range.second; ++it)
+            nodes.push_back(it->second);
+        index_.erase(range.first, range.second);
+        for (Node *node : nodes)
+            list_.erase_node(node);
+        return nodes.size();
+    }
+
+    /**
+     * @brief Erase every element matching @p pred in one pass.
+     *
+     * Same contract as MutableList::erase_if; each removed element also
+     * leaves the index.
+     */
+    template <typename Pred>
+    size_type erase_if(Pred pred)
+    {
+        return list_.erase_if([this, &pred](const T &value) {
+            if (!pred(value))
+                return false;
+            unindex(&value);
+            return true;
+        });
+    }
+
+    /// Remove all elements and index entries
+    void clear()
+    {
+        index_.clear();
+        list_.clear();
+    }
+};
+
+/// Swap two indexed lists
+template <typename T, typename H, typename E, typename A>
+void swap(IndexedMutableList<T, H, E, A> &a, IndexedMutableList<T, H, E, A> &b)
+{
+    a.swap(b);
+}
+
+/// Erase every element of @p list matching @p pred
+template <typename T, typename H, typename E, typename A, typename Pred>
+typename IndexedMutableList<T, H, E, A>::size_type erase_if(IndexedMutableList<T, H, E, A> &list,
+                                                            Pred pred)
+{
+    return list.erase_if(std::move(pred));
+}
+
+#endif // MUTABLE_CHAIN_INDEXED_HPP
@@ -0,0 +1,607 @@
+/**
+ * @file mutable_chain_io.hpp
+ * @brief Checkpoint/restore of MutableList<T> and memory-mapped snapshots
+ *
+ * save(list, path) writes a compact, contiguous snapshot; load<T>(path)
+ * rebuilds a list from it in one pass; MappedChainView<T> iterates a
+ * snapshot straight out of a read-only memory mapping, with no per-element
+ * allocation, so several processes can share one snapshot file.
+ *
+ * @section format FILE FORMAT
+ *
+ * Every file starts with a 64-byte ChainFileHeader followed by the payload:
+ *
+ * - **Records** (trivially copyable T): @c count values of @c elem_size
+ *   bytes, back to back. The payload starts 64 bytes into the file, so a
+ *   mapped view hands out <tt>const T*</tt> directly.
+ * - **Strings** (std::string): <tt>count + 1</tt> uint64 offsets into the
+ *   character blob that follows them; element i is
+ *   <tt>[offsets[i], offsets[i + 1])</tt>. No terminators are stored.
+ *
+ * Values are stored in native byte order; the header records it and files
+ * from a machine with a different byte order are rejected.
+ *
+ * @section hook ADDING A TYPE
+ *
+ * Overload save() for MutableList<U, A> and specialize MappedChainView<U>
+ * with begin()/end() over the mapped bytes; load<U>() then works
+ * unchanged, since it builds the list from the view's iterators.
+ *
+ * @code
+ *     save(prices, "prices.chain");
+ *     auto restored = load<double>("prices.chain");
+ *     MappedChainView<double> view("prices.chain");  // Zero-copy, read-only
+ *     double total = std::accumulate(view.begin(), view.end(), 0.0);
+ * @endcode
+ */
+
+#ifndef MUTABLE_CHAIN_IO_HPP
+#define MUTABLE_CHAIN_IO_HPP
+
+#include "mutable_chain.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ============================================================================
+// FILE HEADER
+// ============================================================================
+
+/// Payload layouts understood by save() / MappedChainView
+enum class ChainFormat : std::uint32_t
+{
+    Records = 1, ///< Fixed-size trivially copyable values
+    Strings = 2  ///< Offset table plus character blob
+};
+
+/**
+ * @brief First 64 bytes of every snapshot file.
+ */
+struct ChainFileHeader
+{
+    char magic[8];              ///< "MCHAIN\0\1"
+    std::uint32_t byte_order;   ///< kByteOrderMark as written by the saver
+    std::uint32_t format;       ///< A ChainFormat value
+    std::uint64_t elem_size;    ///< sizeof(T) for Records, 0 for Strings
+    std::uint64_t count;        ///< Number of elements
+    std::uint64_t payload_size; ///< Bytes following the header
+    char reserved[24];          ///< Zero
+
+    static constexpr std::uint32_t kByteOrderMark = 0x01020304u;
+
+    static ChainFileHeader make(ChainFormat format, std::uint64_t elem_size,
+                                std::uint64_t count, std::uint64_t payload_size)
+    {
+        ChainFileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, "MCHAIN\0\1", 8);
+        header.byte_order = kByteOrderMark;
+        header.format = static_cast<std::uint32_t>(format);
+        header.elem_size = elem_size;
+        header.count = count;
+        header.payload_size = payload_size;
+        return header;
+    }
+
+    /// Throw unless this header describes @p format with @p elem_size and fits @p file_size
+    void validate(ChainFormat expected, std::uint64_t expected_elem_size,
+                  std::uint64_t file_size) const
+    {
+        if (std::memcmp(magic, "MCHAIN\0\1", 8) != 0)
+            throw std::runtime_error("not a MutableList snapshot");
+        if (byte_order != kByteOrderMark)
+            throw std::runtime_error("snapshot was written with a different byte order");
+        if (format != static_cast<std::uint32_t>(expected) || elem_size != expected_elem_size)
+            throw std::runtime_error("snapshot holds a different element type");
+        if (payload_size > file_size - sizeof(ChainFileHeader))
+            throw std::runtime_error("snapshot is truncated");
+    }
+};
+
+static_assert(sizeof(ChainFileHeader) == 64, "ChainFileHeader must stay 64 bytes");
+
+// ============================================================================
+// MAPPED FILE
+// ============================================================================
+
+/**
+ * @brief Read-only memory mapping of a whole file (POSIX mmap or Win32).
+ *
+ * Move-only; the mapping is released by the destructor.
+ */
+class MappedFile
+{
+public:
+    /// Map @p path read-only; throws std::runtime_error on failure
+    explicit MappedFile(const std::string &path)
+    {
+#if defined(_WIN32)
+        file_ = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("cannot open " + path);
+        LARGE_INTEGER size;
+        if (!::GetFileSizeEx(file_, &size))
+        {
+            release();
+            throw std::runtime_error("cannot stat " + path);
+        }
+        size_ = static_cast<std::size_t>(size.QuadPart);
+        if (size_ > 0)
+        {
+            mapping_ = ::CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            void *view = mapping_ ? ::MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+            if (!view)
+            {
+                release();
+                throw std::runtime_error("cannot map " + path);
+            }
+            data_ = static_cast<const unsigned char *>(view);
+        }
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("cannot open " + path);
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("cannot stat " + path);
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ > 0)
+        {
+            void *view = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+            if (view == MAP_FAILED)
+            {
+                ::close(fd);
+                throw std::runtime_error("cannot map " + path);
+            }
+            data_ = static_cast<const unsigned char *>(view);
+        }
+        ::close(fd); // The mapping keeps the file referenced
+#endif
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&other) noexcept { swap(other); }
+
+    MappedFile &operator=(MappedFile &&other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    ~MappedFile() { release(); }
+
+    const unsigned char *data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    const unsigned char *data_ = nullptr; ///< Start of the mapping
+    std::size_t size_ = 0;                ///< Mapped bytes
+#if defined(_WIN32)
+    HANDLE file_ = INVALID_HANDLE_VALUE; ///< Open file handle
+    HANDLE mapping_ = nullptr;           ///< File mapping object
+#endif
+
+    void swap(MappedFile &other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+#if defined(_WIN32)
+        std::swap(file_, other.file_);
+        std::swap(mapping_, other.mapping_);
+#endif
+    }
+
+    void release()
+    {
+#if defined(_WIN32)
+        if (data_)
+            ::UnmapViewOfFile(data_);
+        if (mapping_)
+            ::CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE)
+            ::CloseHandle(file_);
+        file_ = INVALID_HANDLE_VALUE;
+        mapping_ = nullptr;
+#else
+        if (data_)
+            ::munmap(const_cast<unsigned char *>(data_), size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+};
+
+// ============================================================================
+// WRITING
+// ============================================================================
+
+/**
+ * @brief Buffered binary writer used by save(); throws on any I/O error.
+ *
+ * Small values are memcpy'd into a 64 KiB buffer so a snapshot costs a
+ * handful of large writes rather than one call per element.
+ *
+ * Bytes go to <tt>path + ".tmp"</tt>, which close() renames over @p path
+ * only once everything is on disk: a crash or a full disk part-way through
+ * leaves the previous snapshot intact. An unclosed writer removes the
+ * temporary file.
+ */
+class ChainFileWriter
+{
+public:
+    explicit ChainFileWriter(const std::string &path)
+        : path_(path), temp_path_(path + ".tmp"), file_(std::fopen(temp_path_.c_str(), "wb")),
+          buffer_(new char[kBufferSize])
+    {
+        if (!file_)
+            throw std::runtime_error("cannot create " + temp_path_);
+    }
+
+    ChainFileWriter(const ChainFileWriter &) = delete;
+    ChainFileWriter &operator=(const ChainFileWriter &) = delete;
+
+    ~ChainFileWriter()
+    {
+        if (file_)
+        {
+            std::fclose(file_);
+            std::remove(temp_path_.c_str());
+        }
+    }
+
+    void write(const void *data, std::size_t bytes)
+    {
+        if (used_ + bytes > kBufferSize)
+        {
+            flush();
+            if (bytes >= kBufferSize)
+            {
+                put(data, bytes);
+                return;
+            }
+        }
+        std::memcpy(buffer_.get() + used_, data, bytes);
+        used_ += bytes;
+    }
+
+    /// Flush, close and move the file into place; errors surface here rather than in the destructor
+    void close()
+    {
+        flush();
+        std::FILE *file = file_;
+        file_ = nullptr;
+        if (std::fclose(file) != 0)
+        {
+            std::remove(temp_path_.c_str());
+            throw std::runtime_error("cannot write " + path_);
+        }
+#if defined(_WIN32)
+        const bool renamed = ::MoveFileExA(temp_path_.c_str(), path_.c_str(),
+                                           MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        const bool renamed = std::rename(temp_path_.c_str(), path_.c_str()) == 0;
+#endif
+        if (!renamed)
+        {
+            std::remove(temp_path_.c_str());
+            throw std::runtime_error("cannot replace " + path_);
+        }
+    }
+
+private:
+    static constexpr std::size_t kBufferSize = 64 * 1024;
+
+    std::string path_;               ///< Final destination
+    std::string temp_path_;          ///< Written first, renamed over path_ by close()
+    std::FILE *file_;                ///< Open output file
+    std::unique_ptr<char[]> buffer_; ///< Pending bytes
+    std::size_t used_ = 0;           ///< Bytes of buffer_ in use
+
+    void put(const void *data, std::size_t bytes)
+    {
+        if (bytes && std::fwrite(data, 1, bytes, file_) != bytes)
+            throw std::runtime_error("cannot write " + path_);
+    }
+
+    void flush()
+    {
+        put(buffer_.get(), used_);
+        used_ = 0;
+    }
+};
+
+/**
+ * @brief Save a list of trivially copyable values as Records.
+ *
+ * The snapshot replaces @p path atomically (see ChainFileWriter).
+ * @throws std::runtime_error if the file cannot be written
+ */
+template <typename T, typename A, typename S,
+          typename = std::enable_if_t<std::is_trivially_copyable<T>::value>>
+void save(const MutableList<T, A, S> &list, const std::string &path)
+{
+    static_assert(alignof(T) <= sizeof(ChainFileHeader), "mapped records must stay aligned");
+    ChainFileWriter out(path);
+    const ChainFileHeader header = ChainFileHeader::make(
+        ChainFormat::Records, sizeof(T), list.size(), list.size() * sizeof(T));
+    out.write(&header, sizeof(header));
+    for (const T &value : list)
+        out.write(&value, sizeof(T));
+    out.close();
+}
+
+/**
+ * @brief Save a list of strings as an offset table plus character blob.
+ *
+ * The snapshot replaces @p path atomically (see ChainFileWriter).
+ * @throws std::runtime_error if the file cannot be written
+ */
+template <typename A, typename S>
+void save(const MutableList<std::string, A, S> &list, const std::string &path)
+{
+    std::vector<std::uint64_t> offsets;
+    offsets.reserve(list.size() + 1);
+    std::uint64_t offset = 0;
+    offsets.push_back(0);
+    for (const std::string &value : list)
+    {
+        offset += value.size();
+        offsets.push_back(offset);
+    }
+    ChainFileWriter out(path);
+    const std::uint64_t table = offsets.size() * sizeof(std::uint64_t);
+    const ChainFileHeader header =
+        ChainFileHeader::make(ChainFormat::Strings, 0, list.size(), table + offset);
+    out.write(&header, sizeof(header));
+    out.write(offsets.data(), table);
+    for (const std::string &value : list)
+        out.write(value.data(), value.size());
+    out.close();
+}
+
+// ============================================================================
+// MAPPED VIEWS
+// ============================================================================
+
+/**
+ * @brief Read-only, zero-copy view of a Records snapshot.
+ *
+ * Iterators are plain <tt>const T*</tt> into the mapping: iteration is a
+ * contiguous scan with no allocation and no per-element decoding.
+ */
+template <typename T>
+class MappedChainView
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "specialize MappedChainView for non-trivially-copyable types");
+
+public:
+    using value_type = T;                ///< Element type
+    using size_type = std::size_t;       ///< Unsigned integer type for sizes
+    using const_iterator = const T *;    ///< Contiguous iterator into the mapping
+    using iterator = const_iterator;     ///< Views are read-only
+
+    /// Map and validate @p path; throws std::runtime_error if it is not a T snapshot
+    explicit MappedChainView(const std::string &path) : file_(path)
+    {
+        if (file_.size() < sizeof(ChainFileHeader))
+            throw std::runtime_error("not a MutableList snapshot: " + path);
+        ChainFileHeader header;
+        std::memcpy(&header, file_.data(), sizeof(header));
+        header.validate(ChainFormat::Records, sizeof(T), file_.size());
+        // Divide before multiplying: a hostile count must not wrap the product
+        if (header.count > header.payload_size / sizeof(T) ||
+            header.payload_size != header.count * sizeof(T))
+            throw std::runtime_error("snapshot is corrupt: " + path);
+        size_ = static_cast<size_type>(header.count);
+    }
+
+    const_iterator begin() const
+    {
+        return reinterpret_cast<const T *>(file_.data() + sizeof(ChainFileHeader));
+    }
+    const_iterator end() const { return begin() + size_; }
+
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+    [[nodiscard]] size_type size() const { return size_; }
+
+    const T &operator[](size_type i) const { return begin()[i]; }
+
+private:
+    MappedFile file_;   ///< Keeps the mapping alive
+    size_type size_ = 0; ///< Number of elements
+};
+
+/**
+ * @brief One string inside a mapped snapshot (pointer and length, no copy).
+ */
+struct MappedString
+{
+    const char *data;  ///< First character (not NUL-terminated)
+    std::size_t size;  ///< Length in bytes
+
+    /// Copy out into an owning std::string
+    explicit operator std::string() const { return std::string(data, size); }
+
+    bool operator==(const std::string &s) const
+    {
+        return s.size() == size && std::memcmp(s.data(), data, size) == 0;
+    }
+    bool operator!=(const std::string &s) const { return !(*this == s); }
+};
+
+/**
+ * @brief Read-only, zero-copy view of a Strings snapshot.
+ *
+ * Dereferencing yields a MappedString pointing into the mapping.
+ */
+template <>
+class MappedChainView<std::string>
+{
+public:
+    using value_type = MappedString; ///< What iteration yields
+    using size_type = std::size_t;   ///< Unsigned integer type for sizes
+
+    /// Random-access iterator producing MappedString values
+    class const_iterator
+    {
+        friend class MappedChainView;
+        const std::uint64_t *offset_ = nullptr;
+        const char *blob_ = nullptr;
+
+        const_iterator(const std::uint64_t *offset, const char *blob)
+            : offset_(offset), blob_(blob)
+        {
+        }
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = MappedString;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = MappedString;
+
+        const_iterator() = default;
+
+        MappedString operator*() const
+        {
+            return MappedString{blob_ + offset_[0], static_cast<std::size_t>(offset_[1] - offset_[0])};
+        }
+        MappedString operator[](difference_type n) const { return *(*this + n); }
+
+        const_iterator &operator++()
+        {
+            ++offset_;
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            const_iterator tmp = *this;
+            ++offset_;
+            return tmp;
+        }
+        const_iterator &operator--()
+        {
+            --offset_;
+            return *this;
+        }
+        const_iterator operator--(int)
+        {
+            const_iterator tmp = *this;
+            --offset_;
+            return tmp;
+        }
+        const_iterator &operator+=(difference_type n)
+        {
+            offset_ += n;
+            return *this;
+        }
+        const_iterator &operator-=(difference_type n)
+        {
+            offset_ -= n;
+            return *this;
+        }
+        const_iterator operator+(difference_type n) const { return const_iterator(offset_ + n, blob_); }
+        const_iterator operator-(difference_type n) const { return const_iterator(offset_ - n, blob_); }
+        difference_type operator-(const const_iterator &o) const { return offset_ - o.offset_; }
+
+        bool operator==(const const_iterator &o) const { return offset_ == o.offset_; }
+        bool operator!=(const const_iterator &o) const { return offset_ != o.offset_; }
+        bool operator<(const const_iterator &o) const { return offset_ < o.offset_; }
+        bool operator>(const const_iterator &o) const { return offset_ > o.offset_; }
+        bool operator<=(const const_iterator &o) const { return offset_ <= o.offset_; }
+        bool operator>=(const const_iterator &o) const { return offset_ >= o.offset_; }
+    };
+
+    using iterator = const_iterator; ///< Views are read-only
+
+    /// Map and validate @p path; throws std::runtime_error if it is not a string snapshot
+    explicit MappedChainView(const std::string &path) : file_(path)
+    {
+        if (file_.size() < sizeof(ChainFileHeader))
+            throw std::runtime_error("not a MutableList snapshot: " + path);
+        ChainFileHeader header;
+        std::memcpy(&header, file_.data(), sizeof(header));
+        header.validate(ChainFormat::Strings, 0, file_.size());
+        if (header.count >= header.payload_size / sizeof(std::uint64_t))
+            throw std::runtime_error("snapshot is corrupt: " + path);
+        const std::uint64_t table = (header.count + 1) * sizeof(std::uint64_t);
+        if (header.payload_size < table)
+            throw std::runtime_error("snapshot is corrupt: " + path);
+        size_ = static_cast<size_type>(header.count);
+        offsets_ = reinterpret_cast<const std::uint64_t *>(file_.data() + sizeof(ChainFileHeader));
+        blob_ = reinterpret_cast<const char *>(offsets_ + size_ + 1);
+        if (offsets_[0] != 0 || offsets_[size_] != header.payload_size - table)
+            throw std::runtime_error("snapshot is corrupt: " + path);
+        for (size_type i = 0; i < size_; ++i)
+        {
+            if (offsets_[i] > offsets_[i + 1])
+                throw std::runtime_error("snapshot is corrupt: " + path);
+        }
+    }
+
+    const_iterator begin() const { return const_iterator(offsets_, blob_); }
+    const_iterator end() const { return const_iterator(offsets_ + size_, blob_); }
+
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+    [[nodiscard]] size_type size() const { return size_; }
+
+    MappedString operator[](size_type i) const { return begin()[static_cast<std::ptrdiff_t>(i)]; }
+
+private:
+    MappedFile file_;                         ///< Keeps the mapping alive
+    size_type size_ = 0;                      ///< Number of elements
+    const std::uint64_t *offsets_ = nullptr;  ///< count + 1 blob offsets
+    const char *blob_ = nullptr;              ///< Character data
+};
+
+// ============================================================================
+// LOADING
+// ============================================================================
+
+/**
+ * @brief Rebuild a list from a snapshot written by save().
+ *
+ * The file is mapped rather than read, and the list is built as one
+ * pre-linked chain (see MutableList's range constructor).
+ *
+ * @throws std::runtime_error if the file is missing, corrupt or holds another type
+ */
+template <typename T, typename Allocator = std::allocator<T>>
+MutableList<T, Allocator> load(const std::string &path, const Allocator &alloc = Allocator())
+{
+    MappedChainView<T> view(path);
+    return MutableList<T, Allocator>(view.begin(), view.end(), alloc);
+}
+
+#endif // MUTABLE_CHAIN_IO_HPP
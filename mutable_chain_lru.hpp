@@ -0,0 +1,433 @@
+/**
+ * @file mutable_chain_lru.hpp
+ * @brief Least-recently-used cache on a MutableList plus a hash index
+ *
+ * LruCache<K, V> keeps its entries in a MutableList ordered from most to
+ * least recently used, and an unordered index from keys to nodes. A hit is
+ * one hash lookup and MutableList::move_to_front_node: three Ref slot pairs
+ * are rewritten, nothing is allocated, and no iterator (so no pin) is
+ * built. A miss that inserts allocates one node and one index entry.
+ *
+ * When an insert takes the cache past its capacity, the least recently
+ * used entries are evicted from back() as one run (MutableList::erase of a
+ * range), eviction_batch() of them at a time, so a cache that is always
+ * full pays the unlink and the retirement once per batch rather than once
+ * per insert.
+ *
+ * @section lruerase ERASE WHILE ITERATING
+ *
+ * Iteration runs from the most to the least recently used entry and keeps
+ * the MutableList contract: erase(it), erase(key) and evictions may remove
+ * the entry an iterator stands on, and it still advances to the successor.
+ * Iterating does not count as a use; get() does.
+ *
+ * @code
+ *     LruCache<std::string, Response> responses(10000);
+ *     responses.set_eviction_batch(64);
+ *     if (Response *hit = responses.get(url))
+ *         return *hit;                 // Relinked to the front, no allocation
+ *     return responses.put(url, fetch(url));
+ * @endcode
+ */
+
+#ifndef MUTABLE_CHAIN_LRU_HPP
+#define MUTABLE_CHAIN_LRU_HPP
+
+#include "mutable_chain.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+/// Usage counters of an LruCache (see LruCache::stats)
+struct LruCacheStats
+{
+    std::uint64_t hits = 0;      ///< get() calls that found their key
+    std::uint64_t misses = 0;    ///< get() calls that did not
+    std::uint64_t evictions = 0; ///< Entries removed to honour the capacity
+};
+
+/**
+ * @brief Fixed-capacity map that evicts its least recently used entries.
+ *
+ * Not thread-safe: get() reorders the entries, so even lookups need
+ * external synchronization when the cache is shared.
+ *
+ * @tparam Key Key type (hashable with Hash, comparable with KeyEqual)
+ * @tparam Value Mapped type
+ * @tparam Hash Hash function on Key
+ * @tparam KeyEqual Equality on Key
+ * @tparam Allocator Allocator of std::pair<const Key, Value>, for nodes and index
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>>
+class LruCache
+{
+public:
+    // ========================================================================
+    // STL TYPE ALIASES
+    // ========================================================================
+    using key_type = Key;                              ///< Key type
+    using mapped_type = Value;                         ///< Mapped type
+    using value_type = std::pair<const Key, Value>;    ///< Entry type
+    using allocator_type = Allocator;                  ///< Allocator type
+    using hasher = Hash;                               ///< Hash function type
+    using key_equal = KeyEqual;                        ///< Equality type
+    using size_type = std::size_t;                     ///< Unsigned integer type for sizes
+    using reference = value_type &;                    ///< Reference to entry
+    using const_reference = const value_type &;        ///< Const reference to entry
+
+private:
+    using List = MutableList<value_type, Allocator>;
+    using Node = ListNode<value_type>;
+
+    /// Hashes an index key (a pointer to an entry's key) by the key it points to
+    struct KeyHash
+    {
+        Hash hash;
+        std::size_t operator()(const Key *key) const { return hash(*key); }
+    };
+
+    /// Compares index keys by the keys they point to
+    struct KeyEquals
+    {
+        KeyEqual equal;
+        bool operator()(const Key *a, const Key *b) const { return equal(*a, *b); }
+    };
+
+    using Entry = std::pair<const Key *const, Node *>;
+    using Index =
+        std::unordered_map<const Key *, Node *, KeyHash, KeyEquals,
+                           typename std::allocator_traits<Allocator>::template rebind_alloc<Entry>>;
+
+public:
+    using const_iterator = typename List::const_iterator; ///< Most to least recently used
+    using iterator = typename List::iterator;             ///< Most to least recently used
+
+private:
+    List list_;           ///< Entries, most recently used first
+    Index index_;         ///< &node->value.first -> node, for every entry
+    size_type capacity_;  ///< Maximum number of entries
+    size_type batch_ = 1; ///< Entries evicted at once when over capacity
+    LruCacheStats stats_; ///< Hit, miss and eviction counters
+
+    Node *lookup(const Key &key) const
+    {
+        auto entry = index_.find(&key);
+        return entry == index_.end() ? nullptr : entry->second;
+    }
+
+    /// Index the entry just linked at the front, unlinking it again if that throws
+    Value &indexFront()
+    {
+        Node *node = list_.begin().node();
+        try
+        {
+            index_.emplace(&node->value.first, node);
+        }
+        catch (...)
+        {
+            list_.erase_node(node);
+            throw;
+        }
+        return node->value.second;
+    }
+
+    /// Evict down to the capacity, in runs of at least batch_ entries
+    void shrink()
+    {
+        if (list_.size() <= capacity_)
+            return;
+        size_type excess = list_.size() - capacity_;
+        // The entry just used or inserted is at the front and always stays
+        size_type target = excess < batch_ ? batch_ : excess;
+        evict(target < list_.size() ? target : list_.size() - 1);
+    }
+
+    /// Index every node of list_ (after a copy)
+    void rebuildIndex()
+    {
+        index_.reserve(list_.size());
+        for (auto it = list_.begin(); it != list_.end(); ++it)
+            index_.emplace(&it.node()->value.first, it.node());
+    }
+
+public:
+    // ========================================================================
+    // CONSTRUCTION / DESTRUCTION
+    // ========================================================================
+
+    /**
+     * @brief Empty cache holding at most @p capacity entries.
+     * @pre capacity > 0
+     */
+    explicit LruCache(size_type capacity, const Allocator &alloc = Allocator(),
+                      const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual())
+        : list_(alloc), index_(0, KeyHash{hash}, KeyEquals{equal}, alloc), capacity_(capacity)
+    {
+    }
+
+    /// Copy constructor (the copy gets its own index; counters are copied)
+    LruCache(const LruCache &other)
+        : list_(other.list_),
+          index_(0, other.index_.hash_function(), other.index_.key_eq(), list_.get_allocator()),
+          capacity_(other.capacity_), batch_(other.batch_), stats_(other.stats_)
+    {
+        rebuildIndex();
+    }
+
+    /// Move constructor: nodes do not move, so the index moves with them
+    LruCache(LruCache &&other)
+        : list_(std::move(other.list_)), index_(std::move(other.index_)),
+          capacity_(other.capacity_), batch_(other.batch_), stats_(other.stats_)
+    {
+        other.index_.clear();
+    }
+
+    /// Copy assignment (copy and swap)
+    LruCache &operator=(const LruCache &other)
+    {
+        if (this != &other)
+        {
+            LruCache copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    /// Move assignment: takes @p other's entries and index
+    LruCache &operator=(LruCache &&other)
+    {
+        if (this != &other)
+        {
+            LruCache taken(std::move(other));
+            swap(taken);
+        }
+        return *this;
+    }
+
+    /// Swap contents, settings and counters with another cache
+    void swap(LruCache &other)
+    {
+        list_.swap(other.list_);
+        index_.swap(other.index_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(batch_, other.batch_);
+        std::swap(stats_, other.stats_);
+    }
+
+    /// Get a copy of the allocator
+    allocator_type get_allocator() const { return list_.get_allocator(); }
+
+    // ========================================================================
+    // ITERATORS
+    // ========================================================================
+
+    iterator begin() { return list_.begin(); }
+    iterator end() { return list_.end(); }
+    const_iterator begin() const { return list_.begin(); }
+    const_iterator end() const { return list_.end(); }
+    const_iterator cbegin() const { return list_.begin(); }
+    const_iterator cend() const { return list_.end(); }
+
+    // ========================================================================
+    // CAPACITY
+    // ========================================================================
+
+    /// Check if the cache is empty
+    [[nodiscard]] bool empty() const { return list_.empty(); }
+
+    /// Get the number of entries
+    [[nodiscard]] size_type size() const { return list_.size(); }
+
+    /// Maximum number of entries
+    size_type capacity() const { return capacity_; }
+
+    /**
+     * @brief Change the capacity, evicting at once if it shrinks below size().
+     * @pre capacity > 0
+     */
+    void set_capacity(size_type capacity)
+    {
+        capacity_ = capacity;
+        if (list_.size() > capacity_)
+            evict(list_.size() - capacity_);
+    }
+
+    /// Entries evicted at once when an insert goes over capacity
+    size_type eviction_batch() const { return batch_; }
+
+    /**
+     * @brief Evict @p batch entries whenever an insert goes over capacity.
+     *
+     * A full cache then drops to capacity() - batch + 1 entries and takes
+     * batch - 1 inserts before evicting again. The entry being inserted
+     * is never part of the batch.
+     */
+    void set_eviction_batch(size_type batch) { batch_ = batch == 0 ? 1 : batch; }
+
+    /// Size the index for @p count entries, so filling the cache never rehashes
+    void reserve(size_type count) { index_.reserve(count); }
+
+    // ========================================================================
+    // LOOKUP
+    // ========================================================================
+
+    /**
+     * @brief Value for @p key, marked as most recently used.
+     *
+     * A hit relinks the entry to the front in O(1) without allocating and
+     * counts as a hit; a miss counts as a miss.
+     *
+     * @return Pointer to the value, or nullptr if @p key is not cached
+     */
+    Value *get(const Key &key)
+    {
+        Node *node = lookup(key);
+        if (!node)
+        {
+            ++stats_.misses;
+            return nullptr;
+        }
+        ++stats_.hits;
+        list_.move_to_front_node(node);
+        return &node->value.second;
+    }
+
+    /// Value for @p key without marking it as used or counting (nullptr if absent)
+    const Value *peek(const Key &key) const
+    {
+        Node *node = lookup(key);
+        return node ? &node->value.second : nullptr;
+    }
+
+    /// Check whether @p key is cached (not counted, order unchanged)
+    bool contains(const Key &key) const { return lookup(key) != nullptr; }
+
+    /// Least recently used entry (the next to be evicted)
+    const_reference back() const { return list_.back(); }
+
+    /// Most recently used entry
+    const_reference front() const { return list_.front(); }
+
+    // ========================================================================
+    // MODIFIERS
+    // ========================================================================
+
+    /**
+     * @brief Insert or overwrite the value for @p key and mark it as most recently used.
+     *
+     * Inserting may evict least recently used entries (never this one).
+     *
+     * @return Reference to the cached value
+     */
+    template <typename V>
+    Value &put(const Key &key, V &&value)
+    {
+        if (Node *node = lookup(key))
+        {
+            node->value.second = std::forward<V>(value);
+            list_.move_to_front_node(node);
+            return node->value.second;
+        }
+        list_.emplace_front(key, std::forward<V>(value));
+        Value &cached = indexFront();
+        shrink();
+        return cached;
+    }
+
+    /**
+     * @brief Cached value for @p key, constructing it from @p args on a miss.
+     *
+     * Counts as a get(): a hit relinks without allocating, a miss inserts.
+     */
+    template <typename... Args>
+    Value &get_or_emplace(const Key &key, Args &&...args)
+    {
+        if (Value *hit = get(key))
+            return *hit;
+        list_.emplace_front(std::piecewise_construct, std::forward_as_tuple(key),
+                            std::forward_as_tuple(std::forward<Args>(args)...));
+        Value &cached = indexFront();
+        shrink();
+        return cached;
+    }
+
+    /// Remove the entry for @p key; returns whether there was one
+    bool erase(const Key &key)
+    {
+        auto entry = index_.find(&key);
+        if (entry == index_.end())
+            return false;
+        Node *node = entry->second;
+        index_.erase(entry);
+        list_.erase_node(node);
+        return true;
+    }
+
+    /// Remove the entry at @p pos (safe during iteration, as in MutableList)
+    iterator erase(const const_iterator &pos)
+    {
+        Node *node = pos.node();
+        Node *succ = node->next.ptr;
+        index_.erase(&node->value.first);
+        list_.erase_node(node);
+        return list_.iterator_to(succ);
+    }
+
+    /**
+     * @brief Evict the @p count least recently used entries as one run.
+     *
+     * Each leaves the index, then the whole run is unlinked from back() in
+     * one step. Counted as evictions.
+     *
+     * @return Number of entries evicted
+     */
+    size_type evict(size_type count)
+    {
+        if (count > list_.size())
+            count = list_.size();
+        if (count == 0)
+            return 0;
+        auto first = list_.end();
+        for (size_type i = 0; i < count; ++i)
+        {
+            --first;
+            index_.erase(&first->first);
+        }
+        list_.erase(first, list_.end());
+        stats_.evictions += count;
+        return count;
+    }
+
+    /// Remove all entries (not counted as evictions)
+    void clear()
+    {
+        index_.clear();
+        list_.clear();
+    }
+
+    // ========================================================================
+    // COUNTERS
+    // ========================================================================
+
+    /// Hit, miss and eviction counts since construction or reset_stats()
+    LruCacheStats stats() const { return stats_; }
+
+    /// Reset the counters to zero
+    void reset_stats() { stats_ = LruCacheStats(); }
+};
+
+/// Swap two caches
+template <typename K, typename V, typename H, typename E, typename A>
+void swap(LruCache<K, V, H, E, A> &a, LruCache<K, V, H, E, A> &b)
+{
+    a.swap(b);
+}
+
+#endif // MUTABLE_CHAIN_LRU_HPP
@@ -0,0 +1,581 @@
+/**
+ * @file mutable_chain_multi.hpp
+ * @brief Multi-chain list: one allocation per element, linked into N chains
+ *
+ * MultiMutableList<T, N> gives every node N pairs of Ref link slots, one
+ * per chain, so a single element can sit in several orders at once (LRU
+ * order, priority order, owner list) without duplicating its payload.
+ * Chain K is reached through chain<K>(), which has the MutableList
+ * interface for that order:
+ *
+ * @code
+ *     MultiMutableList<Entry, 2> cache;   // chain 0: LRU, chain 1: owner list
+ *     auto *e = cache.emplace_back(key, value);
+ *     cache.chain<0>().move_to_front(e);  // Touch: relinks chain 0 only
+ *     for (auto it = cache.chain<1>().begin(); it != cache.chain<1>().end(); ++it)
+ *         if (it->owner == gone)
+ *             cache.erase(it);            // Leaves every chain; it keeps stepping
+ * @endcode
+ *
+ * @section multierase ERASE WHILE ITERATING
+ *
+ * Each chain is O(1) erase-safe through its own slots: unlinking a node
+ * from chain K rewrites the K slots of its neighbours and leaves the
+ * node's own K slots intact, exactly like MutableList. An element is
+ * destroyed once it has left its last chain; while any iterator is alive
+ * it is retired instead, and retired nodes are freed as soon as the last
+ * iterator lets go, as in MutableList. Chain::for_each pins the list for
+ * the walk, so its callback may erase too.
+ *
+ * The sentinels are embedded in the list object, so the list can be
+ * neither copied nor moved; its iterators must not outlive it.
+ */
+
+#ifndef MUTABLE_CHAIN_MULTI_HPP
+#define MUTABLE_CHAIN_MULTI_HPP
+
+#include "mutable_chain.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// NODE TYPES
+// ============================================================================
+
+/**
+ * @brief The N link slot pairs of a node (also the sentinel type).
+ *
+ * Chain K's sentinel is a bare MultiListLinks that only uses its K slots.
+ */
+template <std::size_t N>
+struct MultiListLinks
+{
+    using RefType = Ref<MultiListLinks>; ///< The Ref type for every chain
+
+    RefType next[N];          ///< Forward link slot per chain (mutated in place)
+    RefType prev[N];          ///< Backward link slot per chain (mutated in place)
+    std::uint32_t chains = 0; ///< Bit K set: currently linked into chain K
+};
+
+/**
+ * @brief Element node of MultiMutableList: N link slot pairs and one value.
+ *
+ * @tparam T The value type stored in this node
+ * @tparam N The number of chains
+ */
+template <typename T, std::size_t N>
+struct MultiListNode : MultiListLinks<N>
+{
+    T value; ///< The stored value, shared by every chain
+
+    /// Value constructor with perfect forwarding
+    template <typename... Args>
+    explicit MultiListNode(Args &&...args) : value(std::forward<Args>(args)...)
+    {
+    }
+};
+
+/**
+ * @brief Elements linked into up to N independent chains.
+ *
+ * @tparam T The element type
+ * @tparam N The number of chains (1 to 32), fixed at compile time
+ * @tparam Allocator The allocator type (default: std::allocator<T>)
+ */
+template <typename T, std::size_t N, typename Allocator = std::allocator<T>>
+class MultiMutableList
+{
+    static_assert(N >= 1 && N <= 32, "MultiMutableList supports 1 to 32 chains");
+
+public:
+    // ========================================================================
+    // STL TYPE ALIASES
+    // ========================================================================
+    using value_type = T;                       ///< Element type
+    using allocator_type = Allocator;           ///< Allocator type
+    using size_type = std::size_t;              ///< Unsigned integer type for sizes
+    using difference_type = std::ptrdiff_t;     ///< Signed integer type for differences
+    using reference = value_type &;             ///< Reference to element
+    using const_reference = const value_type &; ///< Const reference to element
+    using node_type = MultiListNode<T, N>;      ///< Stable handle type returned by emplace
+
+private:
+    using Links = MultiListLinks<N>;
+    using Node = node_type;
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+    using RetiredAllocator = typename NodeTraits::template rebind_alloc<Node *>;
+
+    NodeAllocator alloc_;                        ///< Source of every node
+    Links sentinels_[N];                         ///< Sentinel of chain K (before first, after last)
+    size_type counts_[N] = {};                   ///< Elements linked into chain K
+    size_type size_ = 0;                         ///< Elements in at least one chain
+    mutable std::atomic<size_type> pins_{0};     ///< Live pinned iterators, over every chain
+    std::atomic<bool> reclaiming_{false};        ///< Held by the unpin releasing retired_
+    std::vector<Node *, RetiredAllocator> retired_; ///< Destroyed while iterators were pinned
+
+    Links *sentinel(std::size_t k) const { return const_cast<Links *>(&sentinels_[k]); }
+
+    static Node *asNode(Links *links) { return static_cast<Node *>(links); }
+
+    template <typename... Args>
+    Node *makeNode(Args &&...args)
+    {
+        Node *node = NodeTraits::allocate(alloc_, 1);
+        try
+        {
+            NodeTraits::construct(alloc_, node, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            NodeTraits::deallocate(alloc_, node, 1);
+            throw;
+        }
+        ++size_;
+        return node;
+    }
+
+    void destroyNode(Node *node)
+    {
+        NodeTraits::destroy(alloc_, node);
+        NodeTraits::deallocate(alloc_, node, 1);
+    }
+
+    /// Link @p node into chain @p k just before @p pos
+    void linkBefore(std::size_t k, Links *pos, Links *node)
+    {
+        Links *pred = pos->prev[k].ptr;
+        node->prev[k].ptr = pred;
+        node->next[k].ptr = pos;
+        pred->next[k].ptr = node;
+        pos->prev[k].ptr = node;
+        node->chains |= std::uint32_t(1) << k;
+        ++counts_[k];
+    }
+
+    /// Unlink @p node from chain @p k; its own k slots are left intact
+    void unlink(std::size_t k, Links *node)
+    {
+        Links *pred = node->prev[k].ptr;
+        Links *succ = node->next[k].ptr;
+        // CRITICAL: Update Ref CONTENTS of the neighbours, not the node's own slots
+        pred->next[k].ptr = succ;
+        succ->prev[k].ptr = pred;
+        node->chains &= ~(std::uint32_t(1) << k);
+        --counts_[k];
+    }
+
+    bool pinned() const { return pins_.load(std::memory_order_acquire) != 0; }
+
+    /// Make room for one retired node (the only allocation on erase paths)
+    void reserveRetired()
+    {
+        if (pinned() && retired_.size() == retired_.capacity())
+            retired_.reserve(retired_.size() * 2 + 1);
+    }
+
+    /// Destroy an element that has left every chain (retire it while pinned)
+    void dispose(Node *node)
+    {
+        --size_;
+        if (pinned())
+        {
+            retired_.push_back(node);
+            return;
+        }
+        destroyNode(node);
+        reclaim();
+    }
+
+    /// Free retired nodes once no iterator can stand on them
+    void reclaim()
+    {
+        if (retired_.empty() || pinned())
+            return;
+        for (Node *node : retired_)
+            destroyNode(node);
+        retired_.clear();
+    }
+
+    /// reclaim() from a last unpin, which readers on several threads can reach in turn
+    void reclaimOnce()
+    {
+        if (reclaiming_.exchange(true, std::memory_order_acquire))
+            return; // Another thread's last unpin is releasing them
+        reclaim();
+        reclaiming_.store(false, std::memory_order_release);
+    }
+
+    /// Unlink @p node from chain @p k and dispose of it if that was its last chain
+    void leave(std::size_t k, Node *node)
+    {
+        reserveRetired();
+        unlink(k, node);
+        if (node->chains == 0)
+            dispose(node);
+    }
+
+public:
+    template <std::size_t K>
+    class Chain;
+
+    // ========================================================================
+    // ITERATOR
+    // ========================================================================
+
+    /**
+     * @brief Bidirectional iterator over chain @p K.
+     *
+     * Pins the whole list like a MutableList iterator: any element it
+     * stands on stays allocated, even once erased from every chain, and
+     * stepping follows the node's chain-K slots. If the node is relinked
+     * elsewhere in chain K, the iterator follows it to its new position.
+     * The last iterator to drop its pin frees the retired nodes.
+     */
+    template <std::size_t K, bool IsConst>
+    class ChainIterator
+    {
+        friend class MultiMutableList;
+        friend class Chain<K>;
+        template <std::size_t, bool>
+        friend class ChainIterator;
+
+        Links *current_ = nullptr;
+        MultiMutableList *list_ = nullptr;
+        bool pinned_ = false;
+
+        ChainIterator(Links *node, MultiMutableList *list, bool pin) : current_(node), list_(list)
+        {
+            if (pin)
+                acquire();
+        }
+
+        void acquire()
+        {
+            list_->pins_.fetch_add(1, std::memory_order_relaxed);
+            pinned_ = true;
+        }
+
+        /// Drop the pin; the last one releases retired nodes
+        void release()
+        {
+            if (pinned_ && list_->pins_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                list_->reclaimOnce();
+            pinned_ = false;
+        }
+
+        void step(Links *node)
+        {
+            current_ = node;
+            if (!pinned_)
+                acquire();
+        }
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = std::conditional_t<IsConst, const T, T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = value_type *;
+        using reference = value_type &;
+
+        ChainIterator() = default;
+
+        ChainIterator(const ChainIterator &other) : current_(other.current_), list_(other.list_)
+        {
+            if (other.pinned_)
+                acquire();
+        }
+
+        ChainIterator(ChainIterator &&other) noexcept
+            : current_(other.current_), list_(other.list_), pinned_(other.pinned_)
+        {
+            other.pinned_ = false;
+        }
+
+        /// Allow conversion from non-const to const iterator
+        template <bool WasConst, typename = std::enable_if_t<IsConst && !WasConst>>
+        ChainIterator(const ChainIterator<K, WasConst> &other)
+            : current_(other.current_), list_(other.list_)
+        {
+            if (other.pinned_)
+                acquire();
+        }
+
+        /// Copy/move assignment (copy-and-swap keeps the pin balanced)
+        ChainIterator &operator=(ChainIterator other) noexcept
+        {
+            std::swap(current_, other.current_);
+            std::swap(list_, other.list_);
+            std::swap(pinned_, other.pinned_);
+            return *this;
+        }
+
+        ~ChainIterator() { release(); }
+
+        reference operator*() const { return asNode(current_)->value; }
+        pointer operator->() const { return &asNode(current_)->value; }
+
+        ChainIterator &operator++()
+        {
+            step(current_->next[K].ptr);
+            return *this;
+        }
+
+        ChainIterator operator++(int)
+        {
+            ChainIterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        ChainIterator &operator--()
+        {
+            step(current_->prev[K].ptr);
+            return *this;
+        }
+
+        ChainIterator operator--(int)
+        {
+            ChainIterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        template <bool C>
+        bool operator==(const ChainIterator<K, C> &o) const { return current_ == o.current_; }
+        template <bool C>
+        bool operator!=(const ChainIterator<K, C> &o) const { return current_ != o.current_; }
+
+        /// The element's node (shared by every chain)
+        node_type *node() const { return asNode(current_); }
+    };
+
+    // ========================================================================
+    // CHAIN
+    // ========================================================================
+
+    /**
+     * @brief One chain of the list: MutableList-style access to order @p K.
+     *
+     * A lightweight handle; take it by value from chain<K>(). Linking
+     * operations take node pointers from emplace_back() or node().
+     */
+    template <std::size_t K>
+    class Chain
+    {
+        friend class MultiMutableList;
+        MultiMutableList *list_;
+
+        explicit Chain(MultiMutableList *list) : list_(list) {}
+
+        Links *end_() const { return list_->sentinel(K); }
+
+    public:
+        using iterator = ChainIterator<K, false>;
+        using const_iterator = ChainIterator<K, true>;
+
+        iterator begin() const { return iterator(end_()->next[K].ptr, list_, true); }
+        iterator end() const { return iterator(end_(), list_, false); }
+
+        /// Iterator to @p node, which must be linked into this chain
+        iterator iterator_to(node_type *node) const { return iterator(node, list_, true); }
+
+        [[nodiscard]] bool empty() const { return list_->counts_[K] == 0; }
+        [[nodiscard]] size_type size() const { return list_->counts_[K]; }
+
+        reference front() const { return asNode(end_()->next[K].ptr)->value; }
+        reference back() const { return asNode(end_()->prev[K].ptr)->value; }
+
+        /// Whether @p node is currently linked into this chain
+        bool contains(const node_type *node) const { return (node->chains >> K) & 1u; }
+
+        /// Construct an element linked into this chain only, at its end
+        template <typename... Args>
+        node_type *emplace_back(Args &&...args) const
+        {
+            Node *node = list_->makeNode(std::forward<Args>(args)...);
+            list_->linkBefore(K, end_(), node);
+            return node;
+        }
+
+        /// Link @p node (not yet in this chain) at the end
+        void push_back(node_type *node) const { list_->linkBefore(K, end_(), node); }
+
+        /// Link @p node (not yet in this chain) at the beginning
+        void push_front(node_type *node) const
+        {
+            list_->linkBefore(K, end_()->next[K].ptr, node);
+        }
+
+        /// Link @p node (not yet in this chain) before @p pos
+        void insert(const const_iterator &pos, node_type *node) const
+        {
+            list_->linkBefore(K, pos.current_, node);
+        }
+
+        /// Relink @p node (already in this chain) at the beginning in O(1)
+        void move_to_front(node_type *node) const
+        {
+            if (end_()->next[K].ptr == node)
+                return;
+            list_->unlink(K, node);
+            push_front(node);
+        }
+
+        /// Relink @p node (already in this chain) at the end in O(1)
+        void move_to_back(node_type *node) const
+        {
+            if (end_()->prev[K].ptr == node)
+                return;
+            list_->unlink(K, node);
+            push_back(node);
+        }
+
+        /**
+         * @brief Unlink @p node from this chain only.
+         *
+         * **SAFE DURING ITERATION** of any chain. The element is destroyed
+         * (or retired) if this was the last chain it was in.
+         */
+        void erase(node_type *node) const { list_->leave(K, node); }
+
+        /// Unlink the element at @p pos from this chain; @p pos keeps stepping from it
+        void erase(const const_iterator &pos) const { erase(pos.node()); }
+
+        /// Unlink every element matching @p pred from this chain; returns how many
+        template <typename Pred>
+        size_type erase_if(Pred pred) const
+        {
+            size_type removed = 0;
+            for (Links *node = end_()->next[K].ptr; node != end_();)
+            {
+                Links *next = node->next[K].ptr;
+                if (pred(static_cast<const T &>(asNode(node)->value)))
+                {
+                    erase(asNode(node));
+                    ++removed;
+                }
+                node = next;
+            }
+            return removed;
+        }
+
+        /**
+         * @brief Visit every element of this chain in order.
+         *
+         * The list stays pinned for the whole call, so @p f may erase the
+         * element it is visiting and the walk continues at its successor.
+         */
+        template <typename F>
+        void for_each(F f) const
+        {
+            if (empty())
+                return;
+            iterator guard = begin(); // Pins the list while f runs
+            for (Links *node = end_()->next[K].ptr; node != end_(); node = node->next[K].ptr)
+                f(asNode(node)->value);
+        }
+    };
+
+    // ========================================================================
+    // CONSTRUCTION / DESTRUCTION
+    // ========================================================================
+
+    MultiMutableList() : MultiMutableList(Allocator()) {}
+
+    explicit MultiMutableList(const Allocator &alloc)
+        : alloc_(alloc), retired_(RetiredAllocator(alloc_))
+    {
+        for (std::size_t k = 0; k < N; ++k)
+        {
+            sentinels_[k].next[k].ptr = &sentinels_[k];
+            sentinels_[k].prev[k].ptr = &sentinels_[k];
+        }
+    }
+
+    MultiMutableList(const MultiMutableList &) = delete;
+    MultiMutableList &operator=(const MultiMutableList &) = delete;
+
+    /// Destructor: frees every element once, from the last chain it is in
+    ~MultiMutableList()
+    {
+        for (std::size_t k = 0; k < N; ++k)
+        {
+            for (Links *node = sentinels_[k].next[k].ptr; node != &sentinels_[k];)
+            {
+                Links *next = node->next[k].ptr;
+                node->chains &= ~(std::uint32_t(1) << k);
+                if (node->chains == 0)
+                    destroyNode(asNode(node));
+                node = next;
+            }
+        }
+        for (Node *node : retired_)
+            destroyNode(node);
+    }
+
+    allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+    // ========================================================================
+    // ACCESS
+    // ========================================================================
+
+    /// Chain @p K of the list
+    template <std::size_t K>
+    Chain<K> chain()
+    {
+        static_assert(K < N, "chain index out of range");
+        return Chain<K>(this);
+    }
+
+    /// Number of elements (linked into at least one chain)
+    [[nodiscard]] size_type size() const { return size_; }
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+
+    // ========================================================================
+    // MODIFIERS
+    // ========================================================================
+
+    /// Construct an element and link it at the end of every chain: one allocation
+    template <typename... Args>
+    node_type *emplace_back(Args &&...args)
+    {
+        Node *node = makeNode(std::forward<Args>(args)...);
+        for (std::size_t k = 0; k < N; ++k)
+            linkBefore(k, sentinel(k), node);
+        return node;
+    }
+
+    /**
+     * @brief Unlink @p node from every chain it is in and destroy it.
+     *
+     * **SAFE DURING ITERATION** of any chain; the node is retired while
+     * iterators are alive.
+     */
+    void erase(node_type *node)
+    {
+        reserveRetired();
+        for (std::size_t k = 0; k < N; ++k)
+        {
+            if ((node->chains >> k) & 1u)
+                unlink(k, node);
+        }
+        dispose(node);
+    }
+
+    /// Erase the element at @p pos from every chain; @p pos keeps stepping from it
+    template <std::size_t K, bool C>
+    void erase(const ChainIterator<K, C> &pos)
+    {
+        erase(pos.node());
+    }
+};
+
+#endif // MUTABLE_CHAIN_MULTI_HPP
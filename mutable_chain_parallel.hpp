@@ -0,0 +1,462 @@
+/**
+ * @file mutable_chain_parallel.hpp
+ * @brief Parallel traversal of MutableList<T> on a work-stealing pool
+ *
+ * parallel_for_each(list, f, pool) cuts the list into segments of @c grain
+ * consecutive elements and runs them on a WorkStealingPool. The chain is
+ * walked once, from both ends at the same time: the calling thread cuts the
+ * front half while a pool task cuts the back half, each handing out a
+ * segment as soon as its end is found (so workers start before the walk
+ * finishes). The caller then helps run the remaining segments.
+ *
+ * @section parscale SCALING LIMIT
+ *
+ * A linked list has no random access, so finding the segment boundaries
+ * costs one dependent pointer load per element, and at most two threads
+ * can share that walk. Whatever the pool size, a call therefore takes at
+ * least the time of a serial walk over half the list. Speedup approaches
+ * the worker count only when f costs much more than a pointer chase; for a
+ * light f the walk dominates and a handful of workers is all that helps
+ * (BM_ParallelForEach measured about 1.4x at 4 and 8 workers with the
+ * one-sided walk this replaced).
+ *
+ * @section parerase ERASING FROM f
+ *
+ * With the two-argument form, f receives an EraseHandle and may call
+ * erase() to remove its current element, as the serial erase-while-
+ * iterating loop does. Erasures are recorded per segment and applied
+ * serially once every segment has finished: while segments run, no Ref
+ * slot is rewritten, so workers only ever read the chain's links and each
+ * one writes only the values it owns.
+ *
+ * @code
+ *     WorkStealingPool pool;  // One worker per hardware thread
+ *     parallel_for_each(records, [](Record &r, EraseHandle &current) {
+ *         if (reprocess(r) == Status::Dead)
+ *             current.erase();  // Applied after the parallel phase
+ *     }, pool);
+ * @endcode
+ */
+
+#ifndef MUTABLE_CHAIN_PARALLEL_HPP
+#define MUTABLE_CHAIN_PARALLEL_HPP
+
+#include "mutable_chain.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// WORK-STEALING POOL
+// ============================================================================
+
+/**
+ * @brief Fixed set of worker threads, each with its own task deque.
+ *
+ * A worker runs tasks from the back of its own deque and, when that is
+ * empty, steals from the front of the others'. Idle workers sleep until a
+ * task is submitted. Any thread may submit; run_one() lets a waiting
+ * thread take part instead of blocking.
+ */
+class WorkStealingPool
+{
+public:
+    using Task = std::function<void()>; ///< Unit of work
+
+    /// Start @p threads workers (0 picks std::thread::hardware_concurrency())
+    explicit WorkStealingPool(unsigned threads = 0)
+    {
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        queues_.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i)
+            queues_.emplace_back(new Queue);
+        workers_.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i)
+            workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    /// Finish queued tasks, then join every worker
+    ~WorkStealingPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread &worker : workers_)
+            worker.join();
+    }
+
+    /// Number of worker threads
+    unsigned size() const { return static_cast<unsigned>(workers_.size()); }
+
+    /// Queue @p task on the next worker's deque (round robin)
+    void submit(Task task)
+    {
+        std::size_t index = next_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        {
+            std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+            queues_[index]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            ++queued_;
+        }
+        wake_.notify_one();
+    }
+
+    /// Run one queued task on the calling thread; false if none was found
+    bool run_one()
+    {
+        Task task;
+        if (!steal(next_.load(std::memory_order_relaxed) % queues_.size(), task))
+            return false;
+        task();
+        return true;
+    }
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_; ///< One deque per worker
+    std::vector<std::thread> workers_;           ///< Worker threads
+    std::atomic<std::size_t> next_{0};           ///< Round-robin submit cursor
+    std::mutex sleep_mutex_;                     ///< Guards queued_ and stopping_
+    std::condition_variable wake_;               ///< Signalled on submit and stop
+    std::size_t queued_ = 0;                     ///< Tasks submitted but not yet taken
+    bool stopping_ = false;                      ///< Destructor has started
+
+    /// Take a task: own deque from the back, then the others from the front
+    bool steal(std::size_t self, Task &out)
+    {
+        const std::size_t n = queues_.size();
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            Queue &queue = *queues_[(self + k) % n];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty())
+                continue;
+            if (k == 0)
+            {
+                out = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                out = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            std::lock_guard<std::mutex> sleep(sleep_mutex_);
+            --queued_;
+            return true;
+        }
+        return false;
+    }
+
+    void workerLoop(std::size_t self)
+    {
+        for (;;)
+        {
+            Task task;
+            if (steal(self, task))
+            {
+                task();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            wake_.wait(lock, [this] { return queued_ > 0 || stopping_; });
+            if (stopping_ && queued_ == 0)
+                return;
+        }
+    }
+};
+
+// ============================================================================
+// PARALLEL FOR_EACH
+// ============================================================================
+
+/**
+ * @brief Lets f erase the element it is visiting during parallel_for_each.
+ *
+ * erase() only records the request; the element is unlinked after the
+ * parallel phase. Calling it more than once for the same element is
+ * harmless.
+ */
+class EraseHandle
+{
+    template <typename, typename, typename>
+    friend struct ParallelSegment;
+
+    std::vector<void *> *erased_ = nullptr;
+    void *current_ = nullptr;
+    bool marked_ = false;
+
+public:
+    /// Remove the current element once the parallel phase is over
+    void erase()
+    {
+        if (!marked_)
+            erased_->push_back(current_);
+        marked_ = true;
+    }
+};
+
+/// Detects the EraseHandle form of f
+template <typename F, typename T, typename = void>
+struct TakesEraseHandle : std::false_type
+{
+};
+
+template <typename F, typename T>
+struct TakesEraseHandle<F, T,
+                        decltype(void(std::declval<F &>()(std::declval<T &>(),
+                                                          std::declval<EraseHandle &>())))>
+    : std::true_type
+{
+};
+
+/// Shared state of one parallel_for_each call
+struct ParallelGroup
+{
+    std::mutex mutex;                ///< Guards pending and error
+    std::condition_variable done;    ///< Signalled when pending reaches zero
+    std::size_t pending = 0;         ///< Tasks (segments, back walk) submitted but not finished
+    std::atomic<bool> failed{false}; ///< Set once a task has thrown
+    std::exception_ptr error;        ///< First exception thrown by a task
+
+    /// Register a task before submitting it
+    void enter()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++pending;
+    }
+
+    /// Record the exception being handled, keeping only the first
+    void fail()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!failed.exchange(true))
+            error = std::current_exception();
+    }
+
+    /// Mark a task finished
+    void leave()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--pending == 0)
+            done.notify_all();
+    }
+};
+
+/**
+ * @brief One segment [first, last) of a parallel_for_each call.
+ *
+ * Iterators pin the list, so the segment's nodes cannot be released while
+ * it runs.
+ */
+template <typename List, typename F, typename Handle>
+struct ParallelSegment
+{
+    typename List::iterator first;
+    typename List::iterator last;
+    F *f;
+    std::vector<void *> erased; ///< Nodes f asked to erase, in order
+    ParallelGroup *group;
+
+    void run()
+    {
+        if (!group->failed.load(std::memory_order_relaxed))
+        {
+            try
+            {
+                visit(Handle());
+            }
+            catch (...)
+            {
+                group->fail();
+            }
+        }
+        group->leave();
+    }
+
+private:
+    /// Plain form: f(value)
+    void visit(std::false_type)
+    {
+        for (auto it = first; it != last; ++it)
+            (*f)(*it);
+    }
+
+    /// Erase form: f(value, handle)
+    void visit(std::true_type)
+    {
+        EraseHandle handle;
+        handle.erased_ = &erased;
+        for (auto it = first; it != last; ++it)
+        {
+            handle.current_ = it.node();
+            handle.marked_ = false;
+            (*f)(*it, handle);
+        }
+    }
+};
+
+/**
+ * @brief Apply @p f to every element of @p list on @p pool.
+ *
+ * @p f is called exactly once per element, as f(value) or
+ * f(value, EraseHandle&), from any pool thread or the caller; calls on
+ * different elements may run concurrently. Requested erasures are applied
+ * (serially, on the calling thread) before this returns. If @p f throws,
+ * segments not yet started are skipped, erasures recorded so far are still
+ * applied, and the first exception is rethrown.
+ *
+ * The list must not be modified by anyone else during the call. See the
+ * file comment for why a light @p f does not scale with the pool size.
+ *
+ * @param grain Elements per segment (larger means less scheduling overhead)
+ * @return Number of elements erased
+ */
+template <typename T, typename A, typename S, typename F>
+typename MutableList<T, A, S>::size_type parallel_for_each(MutableList<T, A, S> &list, F f,
+                                                           WorkStealingPool &pool,
+                                                           std::size_t grain = 4096)
+{
+    using List = MutableList<T, A, S>;
+    using Handle = TakesEraseHandle<F, T>;
+    using Segment = ParallelSegment<List, F, Handle>;
+    using Iterator = typename List::iterator;
+    using NodePtr = decltype(std::declval<Iterator &>().node());
+
+    if (grain == 0)
+        grain = 1;
+    ParallelGroup group;
+    std::deque<Segment> front_segments; // Stable addresses while tasks run; list order
+    std::deque<Segment> back_segments;  // Filled by the back walk; reverse list order
+
+    auto submitTask = [&](WorkStealingPool::Task task) {
+        group.enter();
+        try
+        {
+            pool.submit(std::move(task));
+        }
+        catch (...)
+        {
+            group.leave();
+            throw;
+        }
+    };
+
+    auto dispatch = [&](std::deque<Segment> &segments, Iterator first, Iterator last) {
+        segments.push_back(Segment{std::move(first), std::move(last), &f, {}, &group});
+        Segment *segment = &segments.back();
+        submitTask([segment] { segment->run(); });
+    };
+
+    // Help until every segment has finished (segments must outlive their tasks)
+    auto finish = [&] {
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(group.mutex);
+                if (group.pending == 0)
+                    return;
+            }
+            if (!pool.run_one())
+            {
+                std::unique_lock<std::mutex> lock(group.mutex);
+                group.done.wait(lock, [&group] { return group.pending == 0; });
+                return;
+            }
+        }
+    };
+
+    // Walk once from both ends, handing out each segment as soon as its end
+    // is known: a pool task cuts the back half while this thread cuts the front
+    const std::size_t back_count = list.size() / 2;
+    const std::size_t front_count = list.size() - back_count;
+    try
+    {
+        if (back_count > 0)
+        {
+            submitTask([&] {
+                try
+                {
+                    Iterator it = list.end();
+                    for (std::size_t left = back_count; left > 0;)
+                    {
+                        Iterator last = it;
+                        for (std::size_t n = 0; n < grain && left > 0; ++n, --left)
+                            --it;
+                        dispatch(back_segments, it, std::move(last));
+                    }
+                }
+                catch (...)
+                {
+                    group.fail();
+                }
+                group.leave();
+            });
+        }
+        Iterator it = list.begin();
+        for (std::size_t left = front_count; left > 0;)
+        {
+            Iterator first = it;
+            for (std::size_t n = 0; n < grain && left > 0; ++n, --left)
+                ++it;
+            dispatch(front_segments, std::move(first), it);
+        }
+    }
+    catch (...)
+    {
+        finish();
+        throw;
+    }
+    finish();
+
+    typename List::size_type erased = 0;
+    auto apply = [&](Segment &segment) {
+        for (void *node : segment.erased)
+        {
+            list.erase_node(static_cast<NodePtr>(node));
+            ++erased;
+        }
+    };
+    std::for_each(front_segments.begin(), front_segments.end(), apply);
+    std::for_each(back_segments.rbegin(), back_segments.rend(), apply);
+    front_segments.clear(); // Drop the segments' pins before returning
+    back_segments.clear();
+    if (group.error)
+        std::rethrow_exception(group.error);
+    return erased;
+}
+
+/// parallel_for_each() on a process-wide pool with one worker per hardware thread
+template <typename T, typename A, typename S, typename F>
+typename MutableList<T, A, S>::size_type parallel_for_each(MutableList<T, A, S> &list, F f,
+                                                           std::size_t grain = 4096)
+{
+    static WorkStealingPool pool;
+    return parallel_for_each(list, std::move(f), pool, grain);
+}
+
+#endif // MUTABLE_CHAIN_PARALLEL_HPP
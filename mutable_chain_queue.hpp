@@ -0,0 +1,357 @@
+/**
+ * @file mutable_chain_queue.hpp
+ * @brief Lock-free multi-producer / single-consumer work queue
+ *
+ * MpscMutableQueue<T> is the MutableList work-queue pattern (push_back on
+ * producers, pop_front on the consumer) without the mutex that a shared
+ * MutableList needs because emplace_back rewrites tail_->prev.
+ *
+ * @section protocol PROTOCOL
+ *
+ * - **Producers** append with one atomic exchange on the tail slot, followed
+ *   by a release store into the previous last node's next slot. No CAS
+ *   loop, no lock, no retry: every producer finishes in a bounded number of
+ *   steps however many others are appending.
+ * - **The consumer** owns the front. The chain always starts with a
+ *   valueless stub node; popping moves the value out of the stub's
+ *   successor, which then becomes the new stub, so the consumer never
+ *   writes a slot a producer may be writing.
+ * - **Cancellation** is consumer-side erase-by-iterator: erase(it) marks the
+ *   node as cancelled (no producer ever reads that flag) and iteration and
+ *   try_pop_front skip it from then on. As with MutableList, @p it keeps
+ *   stepping from the erased node. The node is freed when try_pop_front
+ *   passes it.
+ *
+ * A producer preempted between its exchange and its link store briefly
+ * hides the elements appended after it: the consumer sees the queue end
+ * there until the store lands.
+ *
+ * Consumer operations (try_pop_front, empty, iteration, erase, erase_if)
+ * must all run on one thread at a time. Serialize consumers externally for
+ * MPMC use; producers never contend with that lock.
+ *
+ * @code
+ *     MpscMutableQueue<Job> jobs;
+ *     // any number of producer threads
+ *     jobs.push_back(make_job());
+ *     // the consumer thread
+ *     jobs.erase_if([](const Job &j) { return j.cancelled(); });
+ *     Job job;
+ *     while (jobs.try_pop_front(job))
+ *         run(job);
+ * @endcode
+ */
+
+#ifndef MUTABLE_CHAIN_QUEUE_HPP
+#define MUTABLE_CHAIN_QUEUE_HPP
+
+#include "mutable_chain.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Node of MpscMutableQueue: a forward link slot plus raw value storage.
+ *
+ * The value is constructed in every node except the current stub (see
+ * ListNodeValue). @c cancelled belongs to the consumer; producers only
+ * initialize it.
+ *
+ * @tparam T The value type stored in this node
+ */
+template <typename T>
+struct QueueNode : ListNodeValue<T>
+{
+    /// Tag selecting the element constructor
+    struct Emplace
+    {
+    };
+
+    std::atomic<QueueNode *> next{nullptr}; ///< Successor, set once by the next producer
+    bool cancelled = false;                 ///< Erased by the consumer, skipped from now on
+
+    /// Stub constructor: no value is constructed
+    QueueNode() {}
+
+    /// Element constructor: the value is built from @p args with perfect forwarding
+    template <typename... Args>
+    explicit QueueNode(Emplace, Args &&...args)
+    {
+        ::new (static_cast<void *>(std::addressof(this->value))) T(std::forward<Args>(args)...);
+    }
+};
+
+/**
+ * @brief Unbounded FIFO with lock-free producers and a lock-free consumer.
+ *
+ * There is no size counter: one would add a contended atomic to every push.
+ * The allocator must be safe to use from every producer thread
+ * (std::allocator is; PoolAllocator is not).
+ *
+ * @tparam T The element type
+ * @tparam Allocator The allocator type (default: std::allocator<T>)
+ */
+template <typename T, typename Allocator = std::allocator<T>>
+class MpscMutableQueue
+{
+public:
+    // ========================================================================
+    // STL TYPE ALIASES
+    // ========================================================================
+    using value_type = T;                       ///< Element type
+    using allocator_type = Allocator;           ///< Allocator type
+    using size_type = std::size_t;              ///< Unsigned integer type for sizes
+    using difference_type = std::ptrdiff_t;     ///< Signed integer type for differences
+    using reference = value_type &;             ///< Reference to element
+    using const_reference = const value_type &; ///< Const reference to element
+
+private:
+    using Node = QueueNode<T>;
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    /// Producer-side tail slot, padded to a cache line so pushes do not
+    /// invalidate the consumer's line (padding rather than alignas, which
+    /// C++14 operator new does not honour)
+    struct TailSlot
+    {
+        std::atomic<Node *> last{nullptr};
+        char pad[64 - sizeof(std::atomic<Node *>)];
+    };
+
+    NodeAllocator alloc_; ///< Source of every node
+    Node *head_;          ///< Consumer: the stub before the first queued element
+    char pad_[64 - sizeof(Node *)];
+    TailSlot tail_; ///< Producers: the last node appended
+
+    template <typename... Args>
+    Node *makeNode(Args &&...args)
+    {
+        Node *node = NodeTraits::allocate(alloc_, 1);
+        try
+        {
+            NodeTraits::construct(alloc_, node, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            NodeTraits::deallocate(alloc_, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    /// Release a node whose value has already been destroyed (or never built)
+    void freeNode(Node *node)
+    {
+        NodeTraits::destroy(alloc_, node);
+        NodeTraits::deallocate(alloc_, node, 1);
+    }
+
+    void destroyValue(Node *node) { std::addressof(node->value)->~T(); }
+
+    /// First node after @p node that is not cancelled, or nullptr
+    static Node *nextLive(const Node *node)
+    {
+        Node *next = node->next.load(std::memory_order_acquire);
+        while (next && next->cancelled)
+            next = next->next.load(std::memory_order_acquire);
+        return next;
+    }
+
+    /// Publish @p node: one exchange on the tail, then link the old last node to it
+    void link(Node *node)
+    {
+        Node *prev = tail_.last.exchange(node, std::memory_order_acq_rel);
+        // CRITICAL: Update the old last node's slot; the consumer acquires it
+        prev->next.store(node, std::memory_order_release);
+    }
+
+public:
+    // ========================================================================
+    // ITERATOR
+    // ========================================================================
+
+    /**
+     * @brief Forward iterator over the queued elements (consumer thread only).
+     *
+     * Skips cancelled elements. Remains valid across erase(); try_pop_front
+     * invalidates iterators to the elements it pops or passes. end() is a
+     * null position, so a walk sees every element linked before it gets
+     * there, including ones pushed during the walk.
+     */
+    template <bool IsConst>
+    class basic_iterator
+    {
+        friend class MpscMutableQueue;
+        Node *current_ = nullptr;
+
+        explicit basic_iterator(Node *node) : current_(node) {}
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<IsConst, const T *, T *>::type;
+        using reference = typename std::conditional<IsConst, const T &, T &>::type;
+
+        basic_iterator() = default;
+
+        /// Conversion from iterator to const_iterator
+        template <bool C = IsConst, typename = typename std::enable_if<C>::type>
+        basic_iterator(const basic_iterator<false> &other) : current_(other.current_)
+        {
+        }
+
+        reference operator*() const { return current_->value; }
+        pointer operator->() const { return std::addressof(current_->value); }
+
+        basic_iterator &operator++()
+        {
+            current_ = nextLive(current_);
+            return *this;
+        }
+
+        basic_iterator operator++(int)
+        {
+            basic_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const basic_iterator &o) const { return current_ == o.current_; }
+        bool operator!=(const basic_iterator &o) const { return current_ != o.current_; }
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    // ========================================================================
+    // CONSTRUCTION / DESTRUCTION
+    // ========================================================================
+
+    MpscMutableQueue() : MpscMutableQueue(Allocator()) {}
+
+    explicit MpscMutableQueue(const Allocator &alloc) : alloc_(alloc), head_(makeNode())
+    {
+        tail_.last.store(head_, std::memory_order_relaxed);
+    }
+
+    MpscMutableQueue(std::initializer_list<T> init, const Allocator &alloc = Allocator())
+        : MpscMutableQueue(alloc)
+    {
+        for (const auto &v : init)
+            push_back(v);
+    }
+
+    MpscMutableQueue(const MpscMutableQueue &) = delete;
+    MpscMutableQueue &operator=(const MpscMutableQueue &) = delete;
+
+    /// Destructor: no producer may still be pushing
+    ~MpscMutableQueue()
+    {
+        Node *node = head_->next.load(std::memory_order_acquire);
+        freeNode(head_);
+        while (node)
+        {
+            Node *next = node->next.load(std::memory_order_acquire);
+            destroyValue(node);
+            freeNode(node);
+            node = next;
+        }
+    }
+
+    allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+    // ========================================================================
+    // PRODUCERS (any thread)
+    // ========================================================================
+
+    /// Construct an element at the back: one allocation and one atomic exchange
+    template <typename... Args>
+    void emplace_back(Args &&...args)
+    {
+        link(makeNode(typename Node::Emplace(), std::forward<Args>(args)...));
+    }
+
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    // ========================================================================
+    // CONSUMER (one thread at a time)
+    // ========================================================================
+
+    iterator begin() { return iterator(nextLive(head_)); }
+    iterator end() { return iterator(); }
+    const_iterator begin() const { return const_iterator(nextLive(head_)); }
+    const_iterator end() const { return const_iterator(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    /// Whether no uncancelled element is visible to the consumer
+    [[nodiscard]] bool empty() const { return nextLive(head_) == nullptr; }
+
+    /**
+     * @brief Move the first uncancelled element into @p out.
+     *
+     * Cancelled nodes in front of it are freed on the way. If the move
+     * assignment throws, the element stays at the front of the queue.
+     *
+     * @return false if no element was visible
+     */
+    bool try_pop_front(T &out)
+    {
+        for (;;)
+        {
+            Node *first = head_->next.load(std::memory_order_acquire);
+            if (!first)
+                return false;
+            const bool cancelled = first->cancelled;
+            if (!cancelled)
+                out = std::move(first->value); // May throw: nothing has been unlinked yet
+            destroyValue(first);
+            freeNode(head_);
+            head_ = first; // First becomes the stub: its value is gone, its slot stays
+            if (!cancelled)
+                return true;
+        }
+    }
+
+    /**
+     * @brief Cancel the element at @p pos.
+     *
+     * **SAFE DURING ITERATION**: @p pos stays dereferenceable and keeps
+     * stepping to the next uncancelled element.
+     *
+     * @return false if it was already cancelled
+     */
+    bool erase(const_iterator pos)
+    {
+        if (pos.current_->cancelled)
+            return false;
+        pos.current_->cancelled = true;
+        return true;
+    }
+
+    /// Cancel every element matching @p pred; returns how many
+    template <typename Pred>
+    size_type erase_if(Pred pred)
+    {
+        size_type removed = 0;
+        for (Node *node = nextLive(head_); node; node = nextLive(node))
+        {
+            if (pred(static_cast<const T &>(node->value)))
+            {
+                node->cancelled = true;
+                ++removed;
+            }
+        }
+        return removed;
+    }
+};
+
+#endif // MUTABLE_CHAIN_QUEUE_HPP
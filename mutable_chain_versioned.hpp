@@ -0,0 +1,661 @@
+/**
+ * @file mutable_chain_versioned.hpp
+ * @brief MutableList variant with O(1) consistent snapshots for readers
+ *
+ * VersionedMutableList<T> lets one writer keep appending and erasing while
+ * reader threads scan a frozen view of the list. snapshot() costs one
+ * registration, not a copy: every node records the version that linked it
+ * and the version that erased it, and a snapshot of version v visits
+ * exactly the nodes linked at or before v and not erased by then.
+ *
+ * @section versions VERSIONS
+ *
+ * Each writer operation publishes a new version number after it has
+ * finished rewriting Ref slots, in the style of ConcurrentMutableList:
+ * - **Insert** builds the node off-list, stamps it and links it with two
+ *   release stores. Older snapshots walk past it.
+ * - **Erase** only stamps the node. It stays linked, so snapshots that
+ *   predate the erase still see it and iterators standing on it still
+ *   step off it.
+ * - **collect()** unlinks erased nodes that no registered version can see
+ *   anymore, and frees them once every reader that might have been walking
+ *   across them has gone. erase_if() and clear() collect on their way out,
+ *   and erase() does so every time enough erased nodes have piled up.
+ *
+ * A reader never takes a lock while iterating: it follows AtomicRef slots
+ * with acquire loads and filters nodes by their stamps. Registering a
+ * version (snapshot(), copying a Snapshot, begin() on the list) takes a
+ * short mutex.
+ *
+ * @section versionedthreads THREADS
+ *
+ * Writer operations (inserts, erasures, collect(), begin()/end() on the
+ * list itself) must not overlap: use one writer thread, or serialize them.
+ * snapshot() may be called from any thread at any time, and a Snapshot may
+ * be iterated on any thread while the writer keeps running. The list must
+ * outlive its snapshots. Iterators are forward-only.
+ *
+ * @code
+ *     VersionedMutableList<Trade> trades;
+ *     // writer thread
+ *     trades.push_back(next_trade());
+ *     trades.erase_if(is_cancelled);
+ *     // reporting threads: a consistent view for the whole scan
+ *     auto view = trades.snapshot();
+ *     for (const Trade &t : view)
+ *         report.add(t);
+ * @endcode
+ */
+
+#ifndef MUTABLE_CHAIN_VERSIONED_HPP
+#define MUTABLE_CHAIN_VERSIONED_HPP
+
+#include "mutable_chain_concurrent.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Node of VersionedMutableList: atomic link slots plus version stamps.
+ *
+ * @c born is written before the node is published and never changes;
+ * @c died is written once, before the version that erases it is published.
+ * Only element nodes hold a constructed value (see ListNodeValue); the list
+ * destroys it before releasing the node.
+ *
+ * @tparam T The value type stored in this node
+ */
+template <typename T>
+struct VersionedListNode : ListNodeValue<T>
+{
+    using RefType = AtomicRef<VersionedListNode<T>>; ///< The Ref type for this node
+    using Version = std::uint64_t;                   ///< Version stamp type
+
+    /// Tag selecting the element constructor
+    struct Emplace
+    {
+    };
+
+    static constexpr Version kLive = std::numeric_limits<Version>::max(); ///< Not erased
+
+    RefType next;                     ///< Forward link slot
+    RefType prev;                     ///< Backward link slot
+    Version born = 0;                 ///< Version that linked the node
+    std::atomic<Version> died{kLive}; ///< Version that erased it, kLive until then
+
+    /// Sentinel constructor: links only, no value is constructed
+    VersionedListNode() {}
+
+    /// Element constructor: the value is built from @p args with perfect forwarding
+    template <typename... Args>
+    explicit VersionedListNode(Emplace, Args &&...args)
+    {
+        ::new (static_cast<void *>(std::addressof(this->value))) T(std::forward<Args>(args)...);
+    }
+
+    /// Whether a reader of version @p v should visit this node
+    bool visibleAt(Version v) const
+    {
+        return born <= v && died.load(std::memory_order_relaxed) > v;
+    }
+};
+
+template <typename T>
+constexpr typename VersionedListNode<T>::Version VersionedListNode<T>::kLive;
+
+/**
+ * @brief Doubly-linked list with cheap, immutable snapshots.
+ *
+ * Element access is const-only: values are shared with every snapshot that
+ * can see the node. size() is the writer's live count.
+ *
+ * @tparam T The element type
+ * @tparam Allocator The allocator type (default: std::allocator<T>)
+ */
+template <typename T, typename Allocator = std::allocator<T>>
+class VersionedMutableList
+{
+public:
+    // ========================================================================
+    // STL TYPE ALIASES
+    // ========================================================================
+    using value_type = T;                       ///< Element type
+    using allocator_type = Allocator;           ///< Allocator type
+    using size_type = std::size_t;              ///< Unsigned integer type for sizes
+    using difference_type = std::ptrdiff_t;     ///< Signed integer type for differences
+    using const_reference = const value_type &; ///< Const reference to element
+    using version_type = std::uint64_t;         ///< Published version number
+
+private:
+    using Node = VersionedListNode<T>;
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+    using DeadAllocator = typename NodeTraits::template rebind_alloc<Node *>;
+
+    /// Unlinked node and the version published after it was unlinked
+    struct Retired
+    {
+        Node *node;
+        version_type tag;
+    };
+    using RetiredAllocator = typename NodeTraits::template rebind_alloc<Retired>;
+
+    using ReaderEntry = std::pair<const version_type, size_type>;
+    using ReaderMap = std::map<version_type, size_type, std::less<version_type>,
+                               typename NodeTraits::template rebind_alloc<ReaderEntry>>;
+
+    static constexpr version_type kLive = Node::kLive;
+    static constexpr version_type kCurrent = kLive - 1; ///< View of the writer's iterators
+    static constexpr size_type kMinCollect = 64;        ///< Erasures before erase() collects
+
+    NodeAllocator alloc_;                          ///< Source of every node
+    Node *head_;                                   ///< Sentinel node before first element
+    Node *tail_;                                   ///< Sentinel node after last element
+    size_type size_ = 0;                           ///< Live elements (writer only)
+    std::atomic<version_type> version_{0};         ///< Latest published version
+    mutable std::mutex readers_mutex_;             ///< Guards readers_
+    mutable ReaderMap readers_;                    ///< Registered version -> reader count
+    std::vector<Node *, DeadAllocator> dead_;      ///< Erased, still linked (writer only)
+    std::vector<Retired, RetiredAllocator> limbo_; ///< Unlinked, tags ascending (writer only)
+    size_type collect_at_ = kMinCollect;           ///< dead_ size that triggers collect()
+
+    /// Allocate an element node, constructing its value from @p args
+    template <typename... Args>
+    Node *makeNode(Args &&...args)
+    {
+        return allocateNode(typename Node::Emplace(), std::forward<Args>(args)...);
+    }
+
+    /// Allocate a sentinel (links only, no value)
+    Node *makeSentinel() { return allocateNode(); }
+
+    template <typename... Args>
+    Node *allocateNode(Args &&...args)
+    {
+        Node *node = NodeTraits::allocate(alloc_, 1);
+        try
+        {
+            NodeTraits::construct(alloc_, node, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            NodeTraits::deallocate(alloc_, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    /// Destroy an element node's value and release the node
+    void destroyNode(Node *node)
+    {
+        node->value.~T();
+        destroySentinel(node);
+    }
+
+    void destroySentinel(Node *node)
+    {
+        NodeTraits::destroy(alloc_, node);
+        NodeTraits::deallocate(alloc_, node, 1);
+    }
+
+    /// Register a reader of the latest version; returns that version
+    version_type enterRead() const
+    {
+        std::lock_guard<std::mutex> lock(readers_mutex_);
+        version_type version = version_.load(std::memory_order_acquire);
+        ++readers_[version];
+        return version;
+    }
+
+    /// Register one more reader of @p version (already held by another reader)
+    void addRead(version_type version) const
+    {
+        std::lock_guard<std::mutex> lock(readers_mutex_);
+        ++readers_[version];
+    }
+
+    void leaveRead(version_type version) const
+    {
+        std::lock_guard<std::mutex> lock(readers_mutex_);
+        auto it = readers_.find(version);
+        if (--it->second == 0)
+            readers_.erase(it);
+    }
+
+    /// Oldest registered version, or kLive when there are no readers
+    version_type oldestReader() const
+    {
+        std::lock_guard<std::mutex> lock(readers_mutex_);
+        return readers_.empty() ? kLive : readers_.begin()->first;
+    }
+
+    /// Link @p node between @p pred and @p succ and publish it as a new version
+    void linkBetween(Node *pred, Node *succ, Node *node)
+    {
+        version_type version = version_.load(std::memory_order_relaxed) + 1;
+        node->born = version;
+        node->prev.ptr.store(pred, std::memory_order_relaxed);
+        node->next.ptr.store(succ, std::memory_order_relaxed);
+        // CRITICAL: Update Ref CONTENTS; readers see node fully built
+        pred->next.store(node);
+        succ->prev.store(node);
+        ++size_;
+        version_.store(version, std::memory_order_release);
+    }
+
+    /// Free unlinked nodes that no reader older than their tag can still reach
+    size_type freeRetired(version_type oldest)
+    {
+        auto it = limbo_.begin();
+        for (; it != limbo_.end() && it->tag <= oldest; ++it)
+            destroyNode(it->node);
+        size_type freed = static_cast<size_type>(it - limbo_.begin());
+        limbo_.erase(limbo_.begin(), it);
+        return freed;
+    }
+
+public:
+    // ========================================================================
+    // READ GUARD
+    // ========================================================================
+
+    /**
+     * @brief RAII registration of a reader at one version.
+     *
+     * While it is alive, no node visible at that version is unlinked, and
+     * no node a reader of that version may be standing on is freed.
+     */
+    class ReadGuard
+    {
+        friend class VersionedMutableList;
+        const VersionedMutableList *list_ = nullptr;
+        version_type version_ = 0;
+        bool active_ = false;
+
+        explicit ReadGuard(const VersionedMutableList &list)
+            : list_(&list), version_(list.enterRead()), active_(true)
+        {
+        }
+
+    public:
+        ReadGuard() = default;
+
+        /// Copy: registers another reader of the same version
+        ReadGuard(const ReadGuard &other) : list_(other.list_), version_(other.version_)
+        {
+            if (other.active_)
+            {
+                list_->addRead(version_);
+                active_ = true;
+            }
+        }
+
+        ReadGuard(ReadGuard &&other) noexcept
+            : list_(other.list_), version_(other.version_), active_(other.active_)
+        {
+            other.active_ = false;
+        }
+
+        ReadGuard &operator=(ReadGuard other) noexcept
+        {
+            std::swap(list_, other.list_);
+            std::swap(version_, other.version_);
+            std::swap(active_, other.active_);
+            return *this;
+        }
+
+        ~ReadGuard()
+        {
+            if (active_)
+                list_->leaveRead(version_);
+        }
+
+        /// Whether this guard is currently registered
+        bool active() const { return active_; }
+
+        /// The version this guard holds
+        version_type version() const { return version_; }
+    };
+
+    // ========================================================================
+    // ITERATOR
+    // ========================================================================
+
+    /**
+     * @brief Forward const iterator over the nodes visible at one version.
+     *
+     * Iterators from a Snapshot rely on the snapshot's registration; the
+     * list's own begin() registers one for the iterator, so erase() and
+     * collect() never pull a node out from under it.
+     */
+    class const_iterator
+    {
+        friend class VersionedMutableList;
+        Node *current_ = nullptr;
+        version_type view_ = 0; ///< Nodes visible at this version are visited
+        ReadGuard guard_;       ///< Registration held by list iterators
+
+        const_iterator(Node *node, version_type view, ReadGuard guard)
+            : current_(node), view_(view), guard_(std::move(guard))
+        {
+            skipHidden();
+        }
+
+        /// Walk past nodes this view does not see (sentinels are always visible)
+        void skipHidden()
+        {
+            while (!current_->visibleAt(view_))
+                current_ = current_->next.load();
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = const T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T *;
+        using reference = const T &;
+
+        const_iterator() = default;
+
+        reference operator*() const { return current_->value; }
+        pointer operator->() const { return &current_->value; }
+
+        const_iterator &operator++()
+        {
+            current_ = current_->next.load();
+            skipHidden();
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const const_iterator &o) const { return current_ == o.current_; }
+        bool operator!=(const const_iterator &o) const { return current_ != o.current_; }
+    };
+
+    using iterator = const_iterator;
+
+    // ========================================================================
+    // SNAPSHOT
+    // ========================================================================
+
+    /**
+     * @brief Immutable view of the list as of one published version.
+     *
+     * Copying a snapshot registers another reader of the same version, so
+     * copies may be handed to other threads.
+     */
+    class Snapshot
+    {
+        friend class VersionedMutableList;
+        const VersionedMutableList *list_ = nullptr;
+        ReadGuard guard_;
+
+        explicit Snapshot(const VersionedMutableList &list) : list_(&list), guard_(list) {}
+
+    public:
+        using value_type = T;                ///< Element type
+        using const_iterator = typename VersionedMutableList::const_iterator;
+        using iterator = const_iterator;     ///< Elements are shared: always const
+
+        Snapshot() = default;
+
+        /// The version this snapshot shows
+        version_type version() const { return guard_.version(); }
+
+        const_iterator begin() const
+        {
+            return const_iterator(list_->head_->next.load(), version(), ReadGuard());
+        }
+
+        const_iterator end() const { return const_iterator(list_->tail_, version(), ReadGuard()); }
+
+        /// Check whether the snapshot shows no elements
+        [[nodiscard]] bool empty() const { return begin() == end(); }
+
+        /// Visit every element of the snapshot in order
+        template <typename F>
+        void for_each(F f) const
+        {
+            for (Node *node = list_->head_->next.load(); node != list_->tail_;
+                 node = node->next.load())
+            {
+                if (node->visibleAt(version()))
+                    f(static_cast<const T &>(node->value));
+            }
+        }
+    };
+
+    // ========================================================================
+    // CONSTRUCTION / DESTRUCTION
+    // ========================================================================
+
+    VersionedMutableList() : VersionedMutableList(Allocator()) {}
+
+    explicit VersionedMutableList(const Allocator &alloc)
+        : alloc_(alloc), head_(makeSentinel()), tail_(makeSentinel()),
+          readers_(std::less<version_type>(), alloc_), dead_(DeadAllocator(alloc_)),
+          limbo_(RetiredAllocator(alloc_))
+    {
+        head_->next.store(tail_);
+        tail_->prev.store(head_);
+    }
+
+    VersionedMutableList(std::initializer_list<T> init, const Allocator &alloc = Allocator())
+        : VersionedMutableList(alloc)
+    {
+        for (const auto &v : init)
+            push_back(v);
+    }
+
+    VersionedMutableList(const VersionedMutableList &) = delete;
+    VersionedMutableList &operator=(const VersionedMutableList &) = delete;
+
+    /// Destructor: no snapshot or iterator may outlive the list
+    ~VersionedMutableList()
+    {
+        for (const Retired &retired : limbo_)
+            destroyNode(retired.node);
+        for (Node *node = head_->next.load(); node != tail_;)
+        {
+            Node *next = node->next.load();
+            destroyNode(node);
+            node = next;
+        }
+        destroySentinel(head_);
+        destroySentinel(tail_);
+    }
+
+    allocator_type get_allocator() const { return allocator_type(alloc_); }
+
+    /**
+     * @brief Register a consistent view of the list as it is now.
+     *
+     * O(1), and safe to call from any thread while the writer runs.
+     */
+    Snapshot snapshot() const { return Snapshot(*this); }
+
+    /// Latest published version
+    version_type version() const { return version_.load(std::memory_order_acquire); }
+
+    // ========================================================================
+    // ITERATORS (writer thread)
+    // ========================================================================
+
+    /// First live element; the iterator holds a registration of its own
+    const_iterator begin() const
+    {
+        return const_iterator(head_->next.load(), kCurrent, ReadGuard(*this));
+    }
+
+    const_iterator end() const { return const_iterator(tail_, kCurrent, ReadGuard()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    // ========================================================================
+    // CAPACITY
+    // ========================================================================
+
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+    [[nodiscard]] size_type size() const { return size_; }
+
+    // ========================================================================
+    // MODIFIERS (writer thread)
+    // ========================================================================
+
+    /// Construct an element at the end, published as a new version
+    template <typename... Args>
+    const_reference emplace_back(Args &&...args)
+    {
+        Node *node = makeNode(std::forward<Args>(args)...);
+        linkBetween(tail_->prev.load(), tail_, node);
+        return node->value;
+    }
+
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    /// Construct an element at the beginning, published as a new version
+    template <typename... Args>
+    const_reference emplace_front(Args &&...args)
+    {
+        Node *node = makeNode(std::forward<Args>(args)...);
+        linkBetween(head_, head_->next.load(), node);
+        return node->value;
+    }
+
+    void push_front(const T &value) { emplace_front(value); }
+    void push_front(T &&value) { emplace_front(std::move(value)); }
+
+    /**
+     * @brief Erase the element at @p pos, published as a new version.
+     *
+     * **SAFE DURING ITERATION**: the node stays linked until collect()
+     * finds no reader that can see it, so @p pos still advances normally.
+     *
+     * @return false if the element was already erased
+     */
+    bool erase(const const_iterator &pos)
+    {
+        Node *node = pos.current_;
+        if (node->died.load(std::memory_order_relaxed) != kLive)
+            return false;
+        dead_.push_back(node);
+        version_type version = version_.load(std::memory_order_relaxed) + 1;
+        node->died.store(version, std::memory_order_relaxed);
+        --size_;
+        version_.store(version, std::memory_order_release);
+        if (dead_.size() >= collect_at_)
+        {
+            collect();
+            collect_at_ = std::max(kMinCollect, dead_.size() * 2);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Erase every element matching @p pred as one version.
+     *
+     * A snapshot sees either all of these erasures or none of them. If
+     * @p pred throws, the erasures made so far are published.
+     *
+     * @return Number of elements removed
+     */
+    template <typename Pred>
+    size_type erase_if(Pred pred)
+    {
+        version_type version = version_.load(std::memory_order_relaxed) + 1;
+        size_type removed = 0;
+        try
+        {
+            for (Node *node = head_->next.load(); node != tail_; node = node->next.load())
+            {
+                if (node->died.load(std::memory_order_relaxed) == kLive &&
+                    pred(static_cast<const T &>(node->value)))
+                {
+                    dead_.push_back(node);
+                    node->died.store(version, std::memory_order_relaxed);
+                    ++removed;
+                }
+            }
+        }
+        catch (...)
+        {
+            size_ -= removed;
+            version_.store(version, std::memory_order_release);
+            throw;
+        }
+        if (removed == 0)
+            return 0;
+        size_ -= removed;
+        version_.store(version, std::memory_order_release);
+        collect();
+        return removed;
+    }
+
+    /// Erase every element as one version
+    void clear()
+    {
+        erase_if([](const T &) { return true; });
+    }
+
+    /**
+     * @brief Unlink erased nodes no reader can see, free those no reader can reach.
+     *
+     * A node is unlinked once every registered version is at least the one
+     * that erased it, and freed once every reader registered before it was
+     * unlinked has gone.
+     *
+     * @return Number of nodes freed
+     */
+    size_type collect()
+    {
+        version_type oldest = oldestReader();
+        version_type tag = version_.load(std::memory_order_relaxed) + 1;
+        limbo_.reserve(limbo_.size() + dead_.size());
+        auto keep = dead_.begin();
+        bool unlinked = false;
+        for (Node *node : dead_)
+        {
+            if (node->died.load(std::memory_order_relaxed) <= oldest)
+            {
+                // CRITICAL: Update neighbours' Ref CONTENTS, not the node's own slots
+                Node *pred = node->prev.load();
+                Node *succ = node->next.load();
+                pred->next.store(succ);
+                succ->prev.store(pred);
+                limbo_.push_back(Retired{node, tag});
+                unlinked = true;
+            }
+            else
+            {
+                *keep++ = node;
+            }
+        }
+        dead_.erase(keep, dead_.end());
+        if (unlinked)
+            version_.store(tag, std::memory_order_release); // Later readers cannot reach them
+        return freeRetired(oldestReader());
+    }
+};
+
+template <typename T, typename A>
+constexpr typename VersionedMutableList<T, A>::size_type VersionedMutableList<T, A>::kMinCollect;
+
+#endif // MUTABLE_CHAIN_VERSIONED_HPP
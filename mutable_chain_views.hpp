@@ -0,0 +1,386 @@
+/**
+ * @file mutable_chain_views.hpp
+ * @brief Lazy filter / transform / take views over MutableList
+ *
+ * A pipeline such as "filter, transform, take 100" is written as
+ *
+ * @code
+ *     auto top = orders | filtered([](const Order &o) { return o.open; })
+ *                       | transformed([](const Order &o) { return o.id; })
+ *                       | taken(100);
+ *     for (auto id : top)
+ *         send(id);
+ * @endcode
+ *
+ * and nothing is copied or allocated: each view holds the one below it by
+ * value and computes elements as its iterator is advanced. Every view
+ * iterator wraps a MutableList iterator, so it pins the list and inherits
+ * its contract: the element under it may be erased (through the view, the
+ * list or another iterator) and the walk carries on from there.
+ *
+ * erase(it) on any view erases the list element under @p it; @p it stays
+ * valid and ++it moves to the next element the view would produce:
+ *
+ * @code
+ *     auto stale = sessions | filtered(is_expired);
+ *     for (auto it = stale.begin(); it != stale.end(); ++it)
+ *         stale.erase(it);
+ * @endcode
+ *
+ * Views refer to the list (and view iterators to their view), so both
+ * must outlive the iterators taken from them, as with std::ranges views.
+ */
+
+#ifndef MUTABLE_CHAIN_VIEWS_HPP
+#define MUTABLE_CHAIN_VIEWS_HPP
+
+#include "mutable_chain.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// ============================================================================
+// VIEWS
+// ============================================================================
+
+/// Tag base identifying the view types (see toView)
+struct ListViewBase
+{
+};
+
+/**
+ * @brief The whole of a MutableList, as the innermost view of a pipeline.
+ *
+ * @tparam List MutableList<...> or const MutableList<...> (read-only views)
+ */
+template <typename List>
+class ListView : public ListViewBase
+{
+    List *list_;
+
+public:
+    using iterator = decltype(std::declval<List &>().begin());
+
+    explicit ListView(List &list) : list_(&list) {}
+
+    iterator begin() const { return list_->begin(); }
+    iterator end() const { return list_->end(); }
+
+    /// List the view walks
+    List &list() const { return *list_; }
+
+    /// Erase the element under @p it; @p it keeps stepping from it
+    void erase(const iterator &it) const { list_->erase(it); }
+};
+
+/**
+ * @brief Elements of @p Base for which @p Pred holds.
+ *
+ * The predicate is evaluated while advancing, so an element that changes
+ * after being passed is not reconsidered.
+ */
+template <typename Base, typename Pred>
+class FilterView : public ListViewBase
+{
+    Base base_;
+    Pred pred_;
+
+    using BaseIt = typename Base::iterator;
+
+public:
+    /// Forward iterator skipping base elements that fail the predicate
+    class iterator
+    {
+        friend class FilterView;
+        BaseIt current_;
+        const FilterView *view_ = nullptr;
+
+        iterator(BaseIt current, const FilterView *view) : current_(std::move(current)), view_(view)
+        {
+            satisfy();
+        }
+
+        /// Advance to the first element at or after current_ that passes
+        void satisfy()
+        {
+            const BaseIt last = view_->base_.end();
+            while (current_ != last && !view_->pred_(*current_))
+                ++current_;
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename std::iterator_traits<BaseIt>::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::iterator_traits<BaseIt>::pointer;
+        using reference = typename std::iterator_traits<BaseIt>::reference;
+
+        iterator() = default;
+
+        reference operator*() const { return *current_; }
+        pointer operator->() const { return std::addressof(*current_); }
+
+        iterator &operator++()
+        {
+            ++current_;
+            satisfy();
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const iterator &o) const { return current_ == o.current_; }
+        bool operator!=(const iterator &o) const { return current_ != o.current_; }
+
+        /// Underlying iterator of the view below
+        const BaseIt &base() const { return current_; }
+    };
+
+    FilterView(Base base, Pred pred) : base_(std::move(base)), pred_(std::move(pred)) {}
+
+    iterator begin() const { return iterator(base_.begin(), this); }
+    iterator end() const { return iterator(base_.end(), this); }
+
+    /// Erase the list element under @p it; @p it keeps stepping from it
+    void erase(const iterator &it) const { base_.erase(it.current_); }
+};
+
+/**
+ * @brief @p F applied to each element of @p Base.
+ *
+ * Values are computed on every dereference; @p F may return a reference
+ * (then the view is writable through it) or a value.
+ */
+template <typename Base, typename F>
+class TransformView : public ListViewBase
+{
+    Base base_;
+    F fn_;
+
+    using BaseIt = typename Base::iterator;
+
+public:
+    /// Forward iterator yielding fn(*base)
+    class iterator
+    {
+        friend class TransformView;
+        BaseIt current_;
+        const TransformView *view_ = nullptr;
+
+        iterator(BaseIt current, const TransformView *view) : current_(std::move(current)), view_(view)
+        {
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using reference = decltype(std::declval<const F &>()(*std::declval<BaseIt &>()));
+        using value_type = std::decay_t<reference>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+
+        iterator() = default;
+
+        reference operator*() const { return view_->fn_(*current_); }
+
+        iterator &operator++()
+        {
+            ++current_;
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const iterator &o) const { return current_ == o.current_; }
+        bool operator!=(const iterator &o) const { return current_ != o.current_; }
+
+        /// Underlying iterator of the view below
+        const BaseIt &base() const { return current_; }
+    };
+
+    TransformView(Base base, F fn) : base_(std::move(base)), fn_(std::move(fn)) {}
+
+    iterator begin() const { return iterator(base_.begin(), this); }
+    iterator end() const { return iterator(base_.end(), this); }
+
+    /// Erase the list element under @p it; @p it keeps stepping from it
+    void erase(const iterator &it) const { base_.erase(it.current_); }
+};
+
+/**
+ * @brief The first @p count elements of @p Base.
+ *
+ * An element erased after it was produced still counts towards @p count:
+ * the view stops after @p count steps, whatever happened to them.
+ */
+template <typename Base>
+class TakeView : public ListViewBase
+{
+    Base base_;
+    std::size_t count_;
+
+    using BaseIt = typename Base::iterator;
+
+public:
+    /// Forward iterator that reaches end() after count steps or at the base end
+    class iterator
+    {
+        friend class TakeView;
+        BaseIt current_;
+        std::size_t left_ = 0; ///< Steps still allowed
+        const TakeView *view_ = nullptr;
+
+        iterator(BaseIt current, std::size_t left, const TakeView *view)
+            : current_(std::move(current)), left_(left), view_(view)
+        {
+        }
+
+        bool atEnd() const { return left_ == 0 || current_ == view_->base_.end(); }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename std::iterator_traits<BaseIt>::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::iterator_traits<BaseIt>::pointer;
+        using reference = typename std::iterator_traits<BaseIt>::reference;
+
+        iterator() = default;
+
+        reference operator*() const { return *current_; }
+        pointer operator->() const { return std::addressof(*current_); }
+
+        iterator &operator++()
+        {
+            ++current_;
+            --left_;
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const iterator &o) const
+        {
+            bool end = atEnd();
+            return end == o.atEnd() && (end || current_ == o.current_);
+        }
+
+        bool operator!=(const iterator &o) const { return !(*this == o); }
+
+        /// Underlying iterator of the view below
+        const BaseIt &base() const { return current_; }
+    };
+
+    TakeView(Base base, std::size_t count) : base_(std::move(base)), count_(count) {}
+
+    iterator begin() const { return iterator(base_.begin(), count_, this); }
+    iterator end() const { return iterator(base_.end(), 0, this); }
+
+    /// Erase the list element under @p it; @p it keeps stepping from it
+    void erase(const iterator &it) const { base_.erase(it.current_); }
+};
+
+// ============================================================================
+// PIPELINE SYNTAX
+// ============================================================================
+
+/// A MutableList enters a pipeline as a ListView
+template <typename T, typename A, typename S>
+ListView<MutableList<T, A, S>> toView(MutableList<T, A, S> &list)
+{
+    return ListView<MutableList<T, A, S>>(list);
+}
+
+/// A const MutableList enters as a read-only ListView
+template <typename T, typename A, typename S>
+ListView<const MutableList<T, A, S>> toView(const MutableList<T, A, S> &list)
+{
+    return ListView<const MutableList<T, A, S>>(list);
+}
+
+/// Views do not own the list: a temporary would be gone before the first step
+template <typename T, typename A, typename S>
+void toView(MutableList<T, A, S> &&) = delete;
+
+/// A view is used as is
+template <typename V, typename = std::enable_if_t<std::is_base_of<ListViewBase, std::decay_t<V>>::value>>
+std::decay_t<V> toView(V &&view)
+{
+    return std::forward<V>(view);
+}
+
+/// Pending filter stage (see filtered())
+template <typename Pred>
+struct FilterStage
+{
+    Pred pred;
+};
+
+/// Pending transform stage (see transformed())
+template <typename F>
+struct TransformStage
+{
+    F fn;
+};
+
+/// Pending take stage (see taken())
+struct TakeStage
+{
+    std::size_t count;
+};
+
+/// Stage keeping the elements for which @p pred holds
+template <typename Pred>
+FilterStage<Pred> filtered(Pred pred)
+{
+    return FilterStage<Pred>{std::move(pred)};
+}
+
+/// Stage replacing each element with @p fn(element)
+template <typename F>
+TransformStage<F> transformed(F fn)
+{
+    return TransformStage<F>{std::move(fn)};
+}
+
+/// Stage keeping the first @p count elements
+inline TakeStage taken(std::size_t count) { return TakeStage{count}; }
+
+template <typename Source, typename Pred>
+auto operator|(Source &&source, FilterStage<Pred> stage)
+{
+    using Base = decltype(toView(std::forward<Source>(source)));
+    return FilterView<Base, Pred>(toView(std::forward<Source>(source)), std::move(stage.pred));
+}
+
+template <typename Source, typename F>
+auto operator|(Source &&source, TransformStage<F> stage)
+{
+    using Base = decltype(toView(std::forward<Source>(source)));
+    return TransformView<Base, F>(toView(std::forward<Source>(source)), std::move(stage.fn));
+}
+
+template <typename Source>
+auto operator|(Source &&source, TakeStage stage)
+{
+    using Base = decltype(toView(std::forward<Source>(source)));
+    return TakeView<Base>(toView(std::forward<Source>(source)), stage.count);
+}
+
+#endif // MUTABLE_CHAIN_VIEWS_HPP